@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../jsmn.hpp"
+
+/*
+ * Compare the C parser with the C++ parser policies on a generated array
+ * of records: tokenizing, then summing one field of every record.
+ *
+ *   bench [megabytes]
+ */
+
+static double now(void) {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+template <class F>
+static double best_of(int runs, F f) {
+    double best = 1e30, t;
+    for (int i = 0; i < runs; i++) {
+        t = now();
+        f();
+        t = now() - t;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+static void report(const char *name, size_t bytes, double secs, const long &check) {
+    printf("%-28s %8.1f MB/s  (%ld)\n", name, bytes / secs / 1e6, check);
+}
+
+template <class P>
+static void bench_cpp(const char *name, const std::string &js, size_t n) {
+    std::vector<jsmn::token<P>> tokens(n);
+    jsmn::parser<P> p;
+    long r = 0, sum = 0;
+
+    report(name, js.size(), best_of(5, [&] {
+        r = p.parse(js, tokens.data(), tokens.size());
+    }), r);
+
+    jsmn::value<P> root(js.data(), tokens.data());
+    report("  lookup id", js.size(), best_of(5, [&] {
+        sum = 0;
+        for (auto v : root.elements())
+            sum += atol(v["id"].text().data());
+    }), sum);
+}
+
+int main(int argc, char **argv) {
+    size_t mb = argc > 1 ? (size_t)atol(argv[1]) : 64, n;
+    std::string js = "[";
+    char rec[256];
+    long i, r = 0, sum = 0;
+    jsmn_parser p;
+
+    for (i = 0; js.size() < mb << 20; i++) {
+        snprintf(rec, sizeof(rec),
+                 "%s{\"name\": \"user %ld\", \"score\": %ld.%02ld, "
+                 "\"tags\": [\"a\", \"b\"], \"active\": true, \"id\": %ld}",
+                 i ? ",\n" : "", i, i % 1000, i % 100, i);
+        js += rec;
+    }
+    js += "]";
+
+    jsmn_init(&p);
+    n = (size_t)jsmn_parse(&p, js.data(), js.size(), NULL, 0);
+    printf("%lu bytes, %lu tokens\n", (unsigned long)js.size(), (unsigned long)n);
+
+    std::vector<jsmntok_t> tokens(n);
+    report("C jsmn_parse", js.size(), best_of(5, [&] {
+        jsmn_init(&p);
+        r = jsmn_parse(&p, js.data(), js.size(), tokens.data(), (unsigned int)n);
+    }), r);
+    report("  lookup id", js.size(), best_of(5, [&] {
+        jsmntok_t *t = jsmn_array_first(tokens.data());
+        sum = 0;
+        for (long k = 0; k < tokens[0].size; k++, t = jsmn_array_next(t))
+            sum += atol(js.data() + jsmn_lookup(js.data(), t, "id")->start);
+    }), sum);
+
+    bench_cpp<jsmn::compat>("C++ compat (C layout)", js, n);
+    bench_cpp<jsmn::lenient>("C++ lenient (skip layout)", js, n);
+    bench_cpp<jsmn::strict>("C++ strict", js, n);
+    bench_cpp<jsmn::policy<false, false, int, true>>("C++ no parent links", js, n);
+    bench_cpp<jsmn::large>("C++ 64 bit offsets", js, n);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include "../jsmn.h"
+
+/*
+ * Print the records of newline delimited JSON on stdin that match a filter
+ * expression, e.g.
+ *
+ *   jsongrep 'level == "error" && latency > 500' < log.ndjson
+ *
+ * -c prints only the number of matching records.
+ * -t prints the scan throughput to stderr.
+ */
+
+static void usage(void) {
+    fprintf(stderr, "usage: jsongrep [-c] [-t] expression < file.ndjson\n");
+    exit(2);
+}
+
+/* print or count the matching records in js[0..len) */
+static size_t grep(const jsmn_filter *filter, const char *js, size_t len,
+        int count_only) {
+    size_t pos = 0, start, end, count = 0;
+
+    while (jsmn_filter_next(filter, js, len, &pos, &start, &end)) {
+        count++;
+        if (!count_only) {
+            fwrite(js + start, 1, end - start, stdout);
+            fputc('\n', stdout);
+        }
+    }
+    return count;
+}
+
+int main(int argc, char **argv) {
+    jsmn_filter filter;
+    char *js = NULL, *p;
+    size_t len = 0, cap = 0, lines, total = 0, count = 0;
+    size_t r;
+    int i, count_only = 0, timing = 0;
+    const char *expr = NULL;
+    clock_t t;
+    double secs = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-c")) count_only = 1;
+        else if (!strcmp(argv[i], "-t")) timing = 1;
+        else if (!expr) expr = argv[i];
+        else usage();
+    }
+    if (!expr) usage();
+
+    jsmn_filter_init(&filter);
+    if ((i = jsmn_filter_compile(&filter, expr)) < 0) {
+        fprintf(stderr, "bad expression: %s\n", jsmn_strerror(i));
+        return 2;
+    }
+
+    /* read in chunks and filter the complete lines of each. the buffer
+       only grows when a single record does not fit */
+    for (;;) {
+        if (len == cap) {
+            cap = cap ? cap * 2 : 1 << 20;
+            if (!(p = realloc(js, cap))) {
+                fprintf(stderr, "realloc(): errno=%d\n", errno);
+                return 3;
+            }
+            js = p;
+        }
+        r = fread(js + len, 1, cap - len, stdin);
+        len += r;
+        total += r;
+
+        lines = len;
+        if (r)
+            while (lines > 0 && js[lines - 1] != '\n')
+                lines--;
+
+        t = clock();
+        count += grep(&filter, js, lines, count_only);
+        secs += (double)(clock() - t) / CLOCKS_PER_SEC;
+
+        memmove(js, js + lines, len - lines);
+        len -= lines;
+        if (r == 0) break;
+    }
+
+    if (count_only)
+        printf("%lu\n", (unsigned long)count);
+    if (timing)
+        fprintf(stderr, "%lu bytes in %.3fs, %.1f MB/s\n", (unsigned long)total,
+                secs, secs > 0 ? total / secs / 1e6 : 0.0);
+
+    jsmn_filter_destroy(&filter);
+    free(js);
+    return count ? EXIT_SUCCESS : 1;
+}
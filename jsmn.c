@@ -1,18 +1,43 @@
 #include "jsmn.h"
+#include "jsmn_sax.h"
 #include <errno.h>
 #include <math.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define JSMN_MMAP_WIN32
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSMN_MMAP_POSIX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSMN_SSE2
+#endif
 
 /**
  * Allocates a fresh unused token from the token pull.
  */
+static int jsmn_key_ids_reserve(jsmn_parser *parser, jsmnuint_t need);
+static int jsmn_hashes_reserve(jsmn_parser *parser, jsmnuint_t need);
+#ifdef JSMN_PARENT_LINKS
+static void jsmn_fp_leaf(jsmn_parser *parser, const char *js, jsmnint_t i);
+static void jsmn_fp_close(jsmn_parser *parser, jsmnint_t i);
+#endif
+
 static jsmntok_t *jsmn_alloc_token(jsmn_parser *parser)
 {
     jsmntok_t *tok;
-    unsigned int sz;
+    jsmnuint_t sz;
+    if (parser->max_tokens && parser->toknext >= parser->max_tokens)
+        return NULL;
     if (parser->toknext >= parser->num_tokens)
     {
         if(parser->owns_tokens)
@@ -20,6 +45,8 @@ static jsmntok_t *jsmn_alloc_token(jsmn_parser *parser)
             sz = parser->num_tokens * 2;
             if(!sz)
                 sz = 64;
+            if(parser->max_tokens && sz > parser->max_tokens)
+                sz = parser->max_tokens;
 #if 0
             fprintf(stderr, "%s:%d reallocating tokens to %d from %d need %d\n",
                     __FILE__, __LINE__,
@@ -32,6 +59,18 @@ static jsmntok_t *jsmn_alloc_token(jsmn_parser *parser)
         }
         else return NULL;
     }
+    if (parser->intern)
+    {
+        if (jsmn_key_ids_reserve(parser, parser->toknext + 1))
+            return NULL;
+        parser->key_ids[parser->toknext] = -1;
+    }
+    if (parser->fingerprint)
+    {
+        if (jsmn_hashes_reserve(parser, parser->toknext + 1))
+            return NULL;
+        parser->hashes[parser->toknext] = 0;
+    }
     tok = &parser->tokens[parser->toknext++];
     tok->start = tok->end = -1;
     tok->size = 0;
@@ -45,7 +84,7 @@ static jsmntok_t *jsmn_alloc_token(jsmn_parser *parser)
  * Fills token type and boundaries.
  */
 static void jsmn_fill_token(jsmntok_t *token, jsmntype_t type,
-                            int start, int end) {
+                            jsmnint_t start, jsmnint_t end) {
     token->type = type;
     token->start = start;
     token->end = end;
@@ -56,35 +95,34 @@ static void jsmn_fill_token(jsmntok_t *token, jsmntype_t type,
  * Fills next available token with JSON primitive.
  */
 static int jsmn_parse_primitive(
-    jsmn_parser *parser, const char *js, size_t len)
+    jsmn_parser *parser, const char *js, size_t len, size_t stop)
 {
     jsmntok_t *token;
-    int start;
+    jsmnuint_t start;
+    size_t pos;
+    int r;
 
     start = parser->pos;
 
-    for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
-        switch (js[parser->pos]) {
-#ifndef JSMN_STRICT
-            /* In strict mode primitive must be followed by "," or "}" or "]" */
-            case ':':
-#endif
-            case '\t' : case '\r' : case '\n' : case ' ' :
-            case ','  : case ']'  : case '}' :
-                goto found;
-        }
-        if (js[parser->pos] < 32 || js[parser->pos] >= 127) {
-            parser->pos = start;
-            return JSMN_ERROR_INVAL;
+    pos = parser->lexed ? parser->lexed : start;
+    r = jsmn_lex_primitive_from(js, stop, &pos);
+    parser->lexed = 0;
+    if (r == 1) {
+        /* cut by the byte budget, continue at pos in the next call */
+        if (stop < len) {
+            parser->lexed = (jsmnuint_t)pos;
+            return JSMN_YIELD;
         }
-    }
 #ifdef JSMN_STRICT
-    /* In strict mode primitive must be followed by a comma/object/array */
-    parser->pos = start;
-    return JSMN_ERROR_PART;
+        r = JSMN_ERROR_PART;
+#else
+        r = 0;
 #endif
+    }
+    if (r < 0)
+        return r;
+    parser->pos = (jsmnuint_t)pos;
 
-found:
     if (parser->tokens == NULL) {
         parser->pos--;
         return 0;
@@ -97,6 +135,8 @@ found:
     jsmn_fill_token(token, JSMN_PRIMITIVE, start, parser->pos);
 #ifdef JSMN_PARENT_LINKS
     token->parent = parser->toksuper;
+    if (parser->fingerprint)
+        jsmn_fp_leaf(parser, js, parser->toknext - 1);
 #endif
     parser->pos--;
     return 0;
@@ -106,79 +146,58 @@ found:
  * Fills next token with JSON string.
  */
 static int jsmn_parse_string(
-    jsmn_parser *parser, const char *js, size_t len)
+    jsmn_parser *parser, const char *js, size_t len, size_t stop)
 {
     jsmntok_t *token;
+    jsmnuint_t start = parser->pos;
+    size_t pos = parser->lexed ? parser->lexed : start + 1;
+    int r;
 
-    int start = parser->pos;
-
-    parser->pos++;
-
-    /* Skip starting quote */
-    for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
-        char c = js[parser->pos];
-
-        /* Quote: end of string */
-        if (c == '\"') {
-            if (parser->tokens == NULL) {
-                return 0;
-            }
-            token = jsmn_alloc_token(parser);
-            if (token == NULL) {
-                parser->pos = start;
-                return JSMN_ERROR_NOMEM;
-            }
-            jsmn_fill_token(token, JSMN_STRING, start+1, parser->pos);
-#ifdef JSMN_PARENT_LINKS
-            token->parent = parser->toksuper;
-#endif
-            return 0;
+    r = jsmn_lex_string_from(js, stop, &pos);
+    parser->lexed = 0;
+    if (r == 1) {
+        if (stop < len) {
+            parser->lexed = (jsmnuint_t)pos;
+            return JSMN_YIELD;
         }
+        r = JSMN_ERROR_PART;
+    }
+    if (r < 0)
+        return r;
+    parser->pos = (jsmnuint_t)pos;
 
-        /* Backslash: Quoted symbol expected */
-        if (c == '\\' && parser->pos + 1 < len) {
-            int i;
-            parser->pos++;
-            switch (js[parser->pos]) {
-                /* Allowed escaped symbols */
-                case '\"': case '/' : case '\\' : case 'b' :
-                case 'f' : case 'r' : case 'n'  : case 't' :
-                    break;
-                /* Allows escaped symbol \uXXXX */
-                case 'u':
-                    parser->pos++;
-                    for(i = 0; i < 4 && parser->pos < len && js[parser->pos] != '\0'; i++) {
-                        /* If it isn't a hex character we have an error */
-                        if(!((js[parser->pos] >= 48 && js[parser->pos] <= 57) || /* 0-9 */
-                                    (js[parser->pos] >= 65 && js[parser->pos] <= 70) || /* A-F */
-                                    (js[parser->pos] >= 97 && js[parser->pos] <= 102))) { /* a-f */
-                            parser->pos = start;
-                            return JSMN_ERROR_INVAL;
-                        }
-                        parser->pos++;
-                    }
-                    parser->pos--;
-                    break;
-                /* Unexpected symbol */
-                default:
-                    parser->pos = start;
-                    return JSMN_ERROR_INVAL;
-            }
-        }
+    if (parser->tokens == NULL) {
+        return 0;
     }
-    parser->pos = start;
-    return JSMN_ERROR_PART;
+    token = jsmn_alloc_token(parser);
+    if (token == NULL) {
+        parser->pos = start;
+        return JSMN_ERROR_NOMEM;
+    }
+    jsmn_fill_token(token, JSMN_STRING, start+1, parser->pos);
+#ifdef JSMN_PARENT_LINKS
+    token->parent = parser->toksuper;
+    if (parser->fingerprint)
+        jsmn_fp_leaf(parser, js, parser->toknext - 1);
+#endif
+    return 0;
 }
 
 /**
  * Parse JSON string and fill tokens.
  */
-int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
-        jsmntok_t *tokens, unsigned int num_tokens) {
+static jsmnint_t jsmn_parse_budget(jsmn_parser *parser, const char *js, size_t len,
+        jsmntok_t *tokens, jsmnuint_t num_tokens) {
     int r;
-    int i;
+    jsmnint_t i;
     jsmntok_t *token;
-    int count = parser->toknext;
+    jsmnint_t count = parser->toknext;
+    size_t stop = len, from;
+
+    /* a token cut by the last slice continues where its lexer stopped */
+    from = parser->lexed ? parser->lexed : parser->pos;
+    if (parser->max_bytes && len - from > parser->max_bytes)
+        stop = from + parser->max_bytes;
 
     if(tokens)
     {
@@ -197,7 +216,7 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
     }
 
 
-    for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
+    for (; parser->pos < stop && js[parser->pos] != '\0'; parser->pos++) {
         char c;
         jsmntype_t type;
 
@@ -208,6 +227,8 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
                 if (parser->tokens == NULL) {
                     break;
                 }
+                if (parser->max_depth && parser->depth >= parser->max_depth)
+                    return JSMN_ERROR_LIMIT;
                 token = jsmn_alloc_token(parser);
                 if (token == NULL)
                     return JSMN_ERROR_NOMEM;
@@ -220,6 +241,7 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
                 token->type = (c == '{' ? JSMN_OBJECT : JSMN_ARRAY);
                 token->start = parser->pos;
                 parser->toksuper = parser->toknext - 1;
+                parser->depth++;
                 break;
             case '}': case ']':
                 if (parser->tokens == NULL)
@@ -237,6 +259,9 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
                         }
                         token->end = parser->pos + 1;
                         parser->toksuper = token->parent;
+                        parser->depth--;
+                        if (parser->fingerprint)
+                            jsmn_fp_close(parser, token - parser->tokens);
                         break;
                     }
                     if (token->parent == -1) {
@@ -256,6 +281,7 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
                         }
                         parser->toksuper = -1;
                         token->end = parser->pos + 1;
+                        parser->depth--;
                         break;
                     }
                 }
@@ -271,7 +297,7 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
 #endif
                 break;
             case '\"':
-                r = jsmn_parse_string(parser, js, len);
+                r = jsmn_parse_string(parser, js, len, stop);
                 if (r < 0) return r;
                 count++;
                 if (parser->toksuper != -1 && parser->tokens != NULL)
@@ -281,6 +307,15 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
                 break;
             case ':':
                 parser->toksuper = parser->toknext - 1;
+                if (parser->intern && parser->tokens != NULL && parser->toksuper != -1 &&
+                        (parser->tokens[parser->toksuper].type == JSMN_STRING ||
+                         parser->tokens[parser->toksuper].type == JSMN_PRIMITIVE)) {
+                    token = &parser->tokens[parser->toksuper];
+                    r = jsmn_intern_id(parser->intern, js + token->start,
+                            token->end - token->start);
+                    if (r < 0) return r;
+                    parser->key_ids[parser->toksuper] = r;
+                }
                 break;
             case ',':
                 if (parser->tokens != NULL && parser->toksuper != -1 &&
@@ -319,7 +354,7 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
             /* In non-strict mode every unquoted value is a primitive */
             default:
 #endif
-                r = jsmn_parse_primitive(parser, js, len);
+                r = jsmn_parse_primitive(parser, js, len, stop);
                 if (r < 0) return r;
                 count++;
                 if (parser->toksuper != -1 && parser->tokens != NULL)
@@ -333,6 +368,8 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
 #endif
         }
     }
+    if (parser->pos < len && js[parser->pos] != '\0')
+        return JSMN_YIELD;
 
     if (parser->tokens != NULL) {
         for (i = parser->toknext - 1; i >= 0; i--) {
@@ -346,12 +383,45 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
     return count;
 }
 
-int jsmn_parse_dynamic(jsmn_parser *parser, const char *js, size_t len)
+jsmnint_t jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
+        jsmntok_t *tokens, jsmnuint_t num_tokens) {
+    jsmnint_t r;
+
+    if (len > JSMN_MAX_LEN)
+        return JSMN_ERROR_INVAL;
+    r = jsmn_parse_budget(parser, js, len, tokens, num_tokens);
+
+    /* out of tokens because of the budget rather than the array */
+    if (r == JSMN_ERROR_NOMEM && parser->max_tokens &&
+            parser->toknext >= parser->max_tokens)
+        return JSMN_ERROR_LIMIT;
+    return r;
+}
+
+typedef struct {
+    jsmn_event_cb cb;
+    void* user;
+} jsmn_event_ctx;
+
+#define JSMN_SAX_NAME jsmn_parse_events_ctx
+#define JSMN_SAX_EMIT(ctx, event, start, end) \
+    ((jsmn_event_ctx*)(ctx))->cb(((jsmn_event_ctx*)(ctx))->user, event, start, end)
+#include "jsmn_sax.h"
+
+jsmnint_t jsmn_parse_events(const char *js, size_t len, jsmn_event_cb cb, void* user)
+{
+    jsmn_event_ctx ctx;
+    ctx.cb = cb;
+    ctx.user = user;
+    return jsmn_parse_events_ctx(js, len, &ctx);
+}
+
+jsmnint_t jsmn_parse_dynamic(jsmn_parser *parser, const char *js, size_t len)
 {
     return jsmn_parse(parser, js, len, NULL, 0);
 }
 
-int jsmn_parse_dynamic_str(jsmn_parser *parser, const char *js)
+jsmnint_t jsmn_parse_dynamic_str(jsmn_parser *parser, const char *js)
 {
     return jsmn_parse_dynamic(parser, js, strlen(js));
 }
@@ -365,15 +435,76 @@ void jsmn_init(jsmn_parser *parser)
     parser->tokens = NULL;
     parser->num_tokens = 0;
     parser->owns_tokens = 0;
+    parser->map = NULL;
+    parser->map_len = 0;
+    parser->intern = NULL;
+    parser->key_ids = NULL;
+    parser->key_ids_cap = 0;
+    parser->fingerprint = 0;
+    parser->hashes = NULL;
+    parser->hashes_cap = 0;
+    parser->max_tokens = 0;
+    parser->max_depth = 0;
+    parser->max_bytes = 0;
+    parser->depth = 0;
+    parser->lexed = 0;
+    parser->pos = 0;
+    parser->toknext = 0;
+    parser->toksuper = -1;
+}
+
+static void jsmn_unmap_file(void* map, size_t len);
+
+void jsmn_reset(jsmn_parser* parser)
+{
+    if(!parser->owns_tokens)
+    {
+        parser->tokens = NULL;
+        parser->num_tokens = 0;
+    }
+    jsmn_unmap_file(parser->map, parser->map_len);
+    parser->map = NULL;
+    parser->map_len = 0;
     parser->pos = 0;
     parser->toknext = 0;
     parser->toksuper = -1;
+    parser->depth = 0;
+    parser->lexed = 0;
 }
+int jsmn_reserve(jsmn_parser* parser, jsmnuint_t num_tokens)
+{
+    jsmntok_t* tok;
+    size_t bytes;
 
+    if(parser->tokens && !parser->owns_tokens)
+        return num_tokens <= parser->num_tokens ? 0 : JSMN_ERROR_NOMEM;
+    if(num_tokens <= parser->num_tokens)
+        return 0;
+    /* jsmnuint_t may be narrower or wider than size_t. num_tokens must fit
+       a size_t and the byte count must not wrap */
+    bytes = (size_t)num_tokens * sizeof(jsmntok_t);
+    if((jsmnuint_t)(size_t)num_tokens != num_tokens ||
+            bytes / sizeof(jsmntok_t) != (size_t)num_tokens)
+        return JSMN_ERROR_NOMEM;
+    if(!(tok = realloc(parser->tokens, bytes)))
+        return JSMN_ERROR_NOMEM;
+    parser->tokens = tok;
+    parser->num_tokens = num_tokens;
+    parser->owns_tokens = 1;
+    return 0;
+}
 void jsmn_destroy(jsmn_parser* parser)
 {
     if(parser->owns_tokens)
         free(parser->tokens);
+    jsmn_unmap_file(parser->map, parser->map_len);
+    parser->map = NULL;
+    free(parser->key_ids);
+    parser->key_ids = NULL;
+    parser->key_ids_cap = 0;
+    free(parser->hashes);
+    parser->hashes = NULL;
+    parser->hashes_cap = 0;
 }
 
 const char* jsmn_strerror(int error_code)
@@ -383,6 +514,10 @@ const char* jsmn_strerror(int error_code)
         case JSMN_ERROR_NOMEM: return "jsmn: Not enough tokens provided";
         case JSMN_ERROR_INVAL: return "jsmn: Invalid character in json string";
         case JSMN_ERROR_PART: return "jsmn: Not full json packet";
+        case JSMN_ERROR_STOPPED: return "jsmn: Stopped by event handler";
+        case JSMN_ERROR_IO: return "jsmn: Read failed";
+        case JSMN_ERROR_LIMIT: return "jsmn: Token or depth limit exceeded";
+        case JSMN_YIELD: return "jsmn: Byte budget used, parse again to continue";
         default: return "jsmn: Success. Token count";
     }
 }
@@ -397,7 +532,7 @@ jsmntok_t* jsmn_array_first(jsmntok_t* token)
 jsmntok_t* jsmn_array_next(jsmntok_t* token)
 {
     jsmntok_t *t, *c;
-    int i;
+    jsmnint_t i;
 
     t = token;
     if(t->type == JSMN_OBJECT)
@@ -422,7 +557,7 @@ jsmntok_t* jsmn_array_next(jsmntok_t* token)
 jsmntok_t* jsmn_obj_next(jsmntok_t* token)
 {
     jsmntok_t *t, *c;
-    int j;
+    jsmnint_t j;
 
 #if 0
     fprintf(stderr, "obj next type=%d\n", token->type);
@@ -464,7 +599,7 @@ jsmntok_t* jsmn_lookup_type(
     const char* key_name,
     jsmntype_t value_type)
 {
-    int i;
+    jsmnint_t i;
     size_t sz = strlen(key_name);
     jsmntok_t* t = token + 1 /* move to first key */, *val;
     for(i=0;i<token->size;i++,t=jsmn_obj_next(t))
@@ -480,7 +615,7 @@ jsmntok_t* jsmn_lookup_type(
 #endif
         val = t+1;
         if((!value_type || val->type == value_type)
-           && sz == t->end - t->start &&
+           && (jsmnint_t)sz == t->end - t->start &&
            !memcmp(key_name, json_text + t->start, sz))
             return val;
     }
@@ -492,7 +627,7 @@ jsmntok_t* jsmn_array_at(jsmntok_t* token, size_t i)
     size_t j;
     jsmntok_t* t;
 
-    if((int)i >= token->size)
+    if((jsmnint_t)i >= token->size)
         return NULL;
 
     t = token + 1;
@@ -525,18 +660,19 @@ char* jsmn_lookup_string_copy(
 }
 void jsmn_print_text(const char* json_text, jsmntok_t* t)
 {
-    fprintf(stderr, "%.*s", t->end - t->start, json_text + t->start);
+    fprintf(stderr, "%.*s", (int)(t->end - t->start), json_text + t->start);
 }
 void jsmn_print_token(const char* json_text, jsmntok_t* t)
 {
-    fprintf(stderr, "start=%d end=%d text='%.*s'\n",
-            t->start,
-            t->end,
-            t->end - t->start,
+    fprintf(stderr, "start=%ld end=%ld text='%.*s'\n",
+            (long)t->start,
+            (long)t->end,
+            (int)(t->end - t->start),
             json_text + t->start);
 }
-jsmntok_t* jsmn_findv(
-    const char* json, jsmntok_t* token,
+/* jsmn_findv with 'a' steps through elements if not NULL */
+static jsmntok_t* jsmn_find_elements(
+    const char* json, jsmntok_t* token, const jsmn_elements* elements,
     const char* path_format, va_list args)
 {
     jsmntok_t* t = token;
@@ -564,12 +700,19 @@ jsmntok_t* jsmn_findv(
             fprintf(stderr, "searching for %d in %d\n", idx, t != NULL);
 #endif
             if(t && t->type == JSMN_ARRAY)
-                t = jsmn_array_at(t, idx);
+                t = elements ? jsmn_elements_at(elements, t, idx) :
+                    jsmn_array_at(t, idx);
         }
         else t = NULL;
     }
     return t;
 }
+jsmntok_t* jsmn_findv(
+    const char* json, jsmntok_t* token,
+    const char* path_format, va_list args)
+{
+    return jsmn_find_elements(json, token, NULL, path_format, args);
+}
 jsmntok_t* jsmn_find(
     const char* json, jsmntok_t* token,
     const char* path_format, ...)
@@ -582,7 +725,7 @@ jsmntok_t* jsmn_find(
     return t;
 }
 
-int jsmn_parse_text(const char *js, jsmntok_t *tokens, unsigned int num_tokens)
+jsmnint_t jsmn_parse_text(const char *js, jsmntok_t *tokens, jsmnuint_t num_tokens)
 {
     jsmn_parser p;
     jsmn_init(&p);
@@ -605,15 +748,24 @@ char* jsmn_find_string_copy(
 
 int jsmn_try_parse_double(const char* json, jsmntok_t* token, double* result)
 {
-    char *end, *start;
+    char num[64], *end, *start = num;
+    size_t len = (size_t)(token->end - token->start);
     double d;
 
     if(token->type != JSMN_PRIMITIVE)
         return 0;
 
-    start = (char*)json + token->start;
+    /* strtod needs a terminator, the text may have none after the token,
+       e.g. the mapping of jsmn_parse_file */
+    if(len >= sizeof(num) && !(start = malloc(len + 1)))
+        return 0;
+    memcpy(start, json + token->start, len);
+    start[len] = '\0';
     d = strtod(start, &end);
-    if(start == end)
+    len = (size_t)(end - start);
+    if(start != num)
+        free(start);
+    if(!len)
         return 0;
 
     if((d == HUGE_VAL || d == -HUGE_VAL || d == 0) && errno == ERANGE)
@@ -648,3 +800,4726 @@ int jsmn_lookup_double(
 
     return 0;
 }
+
+int jsmn_try_parse_int64(const char* json, jsmntok_t* token, int64_t* result)
+{
+    const char *c, *end;
+    uint64_t v = 0;
+    unsigned int d;
+    int neg = 0;
+
+    if(token->type != JSMN_PRIMITIVE)
+        return 0;
+
+    c = json + token->start;
+    end = json + token->end;
+    if(c < end && *c == '-')
+    {
+        neg = 1;
+        ++c;
+    }
+    if(c == end)
+        return 0;
+
+    for(;c<end;++c)
+    {
+        d = (unsigned int)(*c - '0');
+        if(d > 9)
+            return 0;
+        if(v > (UINT64_MAX - d) / 10)
+            return 0;
+        v = v * 10 + d;
+    }
+
+    if(neg)
+    {
+        if(v > (uint64_t)INT64_MAX + 1)
+            return 0;
+        *result = v == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)v;
+    }
+    else
+    {
+        if(v > INT64_MAX)
+            return 0;
+        *result = (int64_t)v;
+    }
+    return 1;
+}
+
+/* match key token against a NUL terminated column name without strlen */
+static int jsmn_key_equals(const char* json, jsmntok_t* key, const char* name)
+{
+    size_t len = (size_t)(key->end - key->start);
+    if(len == 0)
+        return name[0] == '\0';
+    return name[0] == json[key->start] &&
+        !strncmp(name, json + key->start, len) && name[len] == '\0';
+}
+
+static void jsmn_column_clear(jsmncolumn_t* col, jsmnint_t row)
+{
+    switch(col->type)
+    {
+        case JSMN_COLUMN_DOUBLE: ((double*)col->values)[row] = 0; break;
+        case JSMN_COLUMN_INT64: ((int64_t*)col->values)[row] = 0; break;
+        case JSMN_COLUMN_STRING:
+            ((jsmnstr_t*)col->values)[row].start = 0;
+            ((jsmnstr_t*)col->values)[row].end = 0;
+            break;
+    }
+    if(col->valid)
+        col->valid[row] = 0;
+}
+
+static void jsmn_column_set(
+    const char* json, jsmncolumn_t* col, jsmnint_t row, jsmntok_t* val)
+{
+    int ok = 0;
+
+    switch(col->type)
+    {
+        case JSMN_COLUMN_DOUBLE:
+            ok = jsmn_try_parse_double(json, val, (double*)col->values + row);
+            break;
+        case JSMN_COLUMN_INT64:
+            ok = jsmn_try_parse_int64(json, val, (int64_t*)col->values + row);
+            break;
+        case JSMN_COLUMN_STRING:
+            if(val->type == JSMN_STRING)
+            {
+                ((jsmnstr_t*)col->values)[row].start = val->start;
+                ((jsmnstr_t*)col->values)[row].end = val->end;
+                ok = 1;
+            }
+            break;
+    }
+    /* a failed conversion may have left an earlier duplicate's value */
+    if(!ok)
+        jsmn_column_clear(col, row);
+    else if(col->valid)
+        col->valid[row] = 1;
+}
+
+jsmnint_t jsmn_extract_columns(
+    const char* json_text,
+    jsmntok_t* token,
+    jsmncolumn_t* columns,
+    size_t num_columns)
+{
+    jsmntok_t *t, *obj;
+    jsmnint_t row, i;
+    size_t c;
+    const char** names = NULL;
+    jsmn_keyset ks;
+    int use_keyset = 0, id;
+
+    if(token->type != JSMN_ARRAY)
+        return JSMN_ERROR_WRONG_TYPE;
+
+    /* beyond a few columns one hash per key beats a compare per column.
+       duplicate column keys keep the compare loop */
+    if(num_columns > 4 && (names = malloc(num_columns * sizeof(*names))))
+    {
+        for(c=0;c<num_columns;c++)
+            names[c] = columns[c].key;
+        use_keyset = jsmn_keyset_init(&ks, names, (int)num_columns) == 0;
+    }
+
+    t = token + 1;
+    for(row=0;row<token->size;row++)
+    {
+        for(c=0;c<num_columns;c++)
+            jsmn_column_clear(&columns[c], row);
+
+        if(t->type != JSMN_OBJECT)
+        {
+            t = jsmn_array_next(t);
+            continue;
+        }
+
+        obj = t;
+        t = obj + 1; /* move to first key */
+        for(i=0;i<obj->size;i++,t=jsmn_obj_next(t))
+        {
+            if(use_keyset)
+            {
+                if((id = jsmn_keyset_token(&ks, json_text, t)) != JSMN_KEY_UNKNOWN)
+                    jsmn_column_set(json_text, &columns[id], row, t + 1);
+                continue;
+            }
+            for(c=0;c<num_columns;c++)
+                if(jsmn_key_equals(json_text, t, columns[c].key))
+                    jsmn_column_set(json_text, &columns[c], row, t + 1);
+        }
+    }
+    if(use_keyset)
+        jsmn_keyset_destroy(&ks);
+    free(names);
+    return token->size;
+}
+
+int jsmn_reader_init(jsmn_reader* reader, jsmn_read_cb read_cb, void* user,
+    char* buf, size_t size)
+{
+    memset(reader, 0, sizeof(*reader));
+    reader->read = read_cb;
+    reader->user = user;
+    if(!buf)
+    {
+        if(!size)
+            size = JSMN_READER_BUFSIZ;
+        if(!(buf = malloc(size)))
+            return JSMN_ERROR_NOMEM;
+        reader->owns_buf = 1;
+    }
+    reader->buf = buf;
+    reader->cap = size;
+    return 0;
+}
+
+void jsmn_reader_init_buffer(jsmn_reader* reader, const char* js, size_t len)
+{
+    memset(reader, 0, sizeof(*reader));
+    reader->buf = (char*)js;
+    reader->cap = reader->len = len;
+    reader->eof = 1;
+}
+
+void jsmn_reader_destroy(jsmn_reader* reader)
+{
+    if(reader->owns_buf)
+        free(reader->buf);
+}
+
+/* drop window bytes before keep and read more input behind the rest.
+   returns bytes read, 0 at end of input */
+static int jsmn_reader_fill(jsmn_reader* r, size_t keep)
+{
+    char* b;
+    int got;
+
+    if(r->eof)
+        return 0;
+
+    if(keep)
+    {
+        memmove(r->buf, r->buf + keep, r->len - keep);
+        r->len -= keep;
+        r->pos -= keep;
+        r->base += keep;
+    }
+    if(r->len == r->cap)
+    {
+        if(!r->owns_buf)
+            return JSMN_ERROR_NOMEM;
+        if(!(b = realloc(r->buf, r->cap * 2)))
+            return JSMN_ERROR_NOMEM;
+        r->buf = b;
+        r->cap *= 2;
+    }
+
+    got = r->read(r->user, r->buf + r->len, r->cap - r->len);
+    if(got < 0)
+        return JSMN_ERROR_IO;
+    if(got == 0)
+        r->eof = 1;
+    r->len += got;
+    return got;
+}
+
+/* lex the string or primitive at r->pos, refilling until it is complete.
+   *end is the window offset the lexer stopped at */
+static int jsmn_reader_lex(jsmn_reader* r, int string, size_t* end)
+{
+    size_t p;
+    int rc;
+
+    for(;;)
+    {
+        p = r->pos;
+        if(string)
+            rc = jsmn_lex_string(r->buf, r->len, &p);
+        else
+            rc = jsmn_lex_primitive(r->buf, r->len, &p);
+
+        /* a primitive ending at the window edge may continue after it */
+        if(!r->eof && (rc == JSMN_ERROR_PART || (!string && !rc && p == r->len)))
+        {
+            if((rc = jsmn_reader_fill(r, r->pos)) < 0)
+                return rc;
+            continue;
+        }
+        if(rc < 0)
+            return rc;
+        *end = p;
+        return 0;
+    }
+}
+
+/* skip whitespace, colons and commas. returns next significant character,
+   0 at end of input or < 0 on error */
+static int jsmn_reader_peek(jsmn_reader* r)
+{
+    int rc;
+    char c;
+
+    for(;;)
+    {
+        if(r->pos >= r->len)
+        {
+            if((rc = jsmn_reader_fill(r, r->pos)) < 0)
+                return rc;
+            if(rc == 0)
+                return 0;
+            continue;
+        }
+        c = r->buf[r->pos];
+        switch(c)
+        {
+            case '\t' : case '\r' : case '\n' : case ' ': case ':':
+                r->pos++;
+                break;
+            case ',':
+                r->expect_key = r->depth > 0 && r->is_object[r->depth - 1];
+                r->pos++;
+                break;
+            case '\0':
+                return 0;
+            default:
+                return (unsigned char)c;
+        }
+    }
+}
+
+/* skip an object or array starting at r->pos by counting brackets */
+static int jsmn_reader_skip_container(jsmn_reader* r)
+{
+    size_t end;
+    int depth = 0;
+    int rc;
+    char c;
+
+    for(;;)
+    {
+        if(r->pos >= r->len)
+        {
+            if((rc = jsmn_reader_fill(r, r->pos)) < 0)
+                return rc;
+            if(rc == 0)
+                return JSMN_ERROR_PART;
+            continue;
+        }
+        c = r->buf[r->pos];
+        if(c == '\"')
+        {
+            if((rc = jsmn_reader_lex(r, 1, &end)) < 0)
+                return rc;
+            r->pos = end;
+        }
+        else if(c == '{' || c == '[')
+            depth++;
+        else if(c == '}' || c == ']')
+        {
+            if(--depth == 0)
+            {
+                r->pos++;
+                return 0;
+            }
+        }
+        else if(c == '\0')
+            return JSMN_ERROR_PART;
+        r->pos++;
+    }
+}
+
+int jsmn_next(jsmn_reader* r, jsmn_event* ev)
+{
+    size_t end;
+    int c, rc;
+
+    c = jsmn_reader_peek(r);
+    if(c < 0)
+        return c;
+    if(c == 0)
+        return r->depth ? JSMN_ERROR_PART : 0;
+
+    switch(c)
+    {
+        case '{': case '[':
+            if(r->depth == JSMN_MAX_DEPTH)
+                return JSMN_ERROR_NOMEM;
+            r->expect_key = c == '{';
+            ev->type = c == '{' ? JSMN_EVENT_OBJECT_START : JSMN_EVENT_ARRAY_START;
+            ev->start = r->base + r->pos;
+            ev->end = ev->start + 1;
+            ev->text = NULL;
+            ev->depth = r->depth;
+            r->is_object[r->depth] = (unsigned char)r->expect_key;
+            r->open[r->depth++] = ev->start;
+            r->pos++;
+            return 1;
+        case '}': case ']':
+            if(r->depth == 0 || r->is_object[r->depth - 1] != (c == '}'))
+                return JSMN_ERROR_INVAL;
+            r->depth--;
+            r->expect_key = 0;
+            ev->type = c == '}' ? JSMN_EVENT_OBJECT_END : JSMN_EVENT_ARRAY_END;
+            ev->start = r->open[r->depth];
+            ev->end = r->base + r->pos + 1;
+            ev->text = NULL;
+            ev->depth = r->depth;
+            r->pos++;
+            return 1;
+        case '\"':
+            if((rc = jsmn_reader_lex(r, 1, &end)) < 0)
+                return rc;
+            ev->type = r->expect_key ? JSMN_EVENT_KEY : JSMN_EVENT_STRING;
+            ev->start = r->base + r->pos + 1;
+            ev->end = r->base + end;
+            ev->text = r->buf + r->pos + 1;
+            ev->depth = r->depth;
+            r->expect_key = 0;
+            r->pos = end + 1;
+            return 1;
+        default:
+#ifdef JSMN_STRICT
+            /* In strict mode primitives are numbers and booleans and
+               must not be keys of the object */
+            if(r->expect_key || !strchr("-0123456789tfn", c))
+                return JSMN_ERROR_INVAL;
+#endif
+            if((rc = jsmn_reader_lex(r, 0, &end)) < 0)
+                return rc;
+            ev->type = r->expect_key ? JSMN_EVENT_KEY : JSMN_EVENT_PRIMITIVE;
+            ev->start = r->base + r->pos;
+            ev->end = r->base + end;
+            ev->text = r->buf + r->pos;
+            ev->depth = r->depth;
+            r->expect_key = 0;
+            r->pos = end;
+            return 1;
+    }
+}
+
+int jsmn_skip_value(jsmn_reader* r)
+{
+    jsmn_event ev;
+    int c, rc;
+
+    c = jsmn_reader_peek(r);
+    if(c <= 0 || c == '}' || c == ']')
+        return c < 0 ? c : 0;
+
+    if(r->expect_key)
+    {
+        /* skip the key, then its value */
+        if((rc = jsmn_next(r, &ev)) < 0)
+            return rc;
+        if((c = jsmn_reader_peek(r)) <= 0)
+            return c < 0 ? c : JSMN_ERROR_PART;
+    }
+
+    if(c == '{' || c == '[')
+    {
+        if((rc = jsmn_reader_skip_container(r)) < 0)
+            return rc;
+        r->expect_key = 0;
+        return 1;
+    }
+    if(c == '}' || c == ']')
+        return JSMN_ERROR_INVAL;
+    if((rc = jsmn_next(r, &ev)) < 0)
+        return rc;
+    return 1;
+}
+
+void jsmn_filter_init(jsmn_filter* f)
+{
+    f->num_clauses = 0;
+}
+
+void jsmn_filter_destroy(jsmn_filter* f)
+{
+    int i, j;
+    for(i=0;i<f->num_clauses;i++)
+    {
+        for(j=0;j<f->clauses[i].depth;j++)
+            free(f->clauses[i].steps[j].key);
+        free(f->clauses[i].steps);
+        free(f->clauses[i].value);
+    }
+    f->num_clauses = 0;
+}
+
+static int jsmn_filter_begin(
+    jsmn_filter* f, jsmnfilterop_t op, const char* value, size_t len)
+{
+    jsmn_filter_clause* c;
+    char* end;
+
+    if(f->num_clauses == JSMN_FILTER_MAX_CLAUSES)
+        return JSMN_ERROR_NOMEM;
+
+    c = &f->clauses[f->num_clauses];
+    memset(c, 0, sizeof(*c));
+    c->op = op;
+    c->value_type = JSMN_PRIMITIVE;
+    if(op != JSMN_FILTER_EXISTS)
+    {
+        if(!value || !len)
+            return JSMN_ERROR_INVAL;
+        if(value[0] == '\"')
+        {
+            if(len < 2 || value[len - 1] != '\"')
+                return JSMN_ERROR_INVAL;
+            c->value_type = JSMN_STRING;
+            ++value;
+            len -= 2;
+        }
+        if(!(c->value = malloc(len + 1)))
+            return JSMN_ERROR_NOMEM;
+        memcpy(c->value, value, len);
+        c->value[len] = '\0';
+        c->value_len = len;
+        if(c->value_type == JSMN_PRIMITIVE)
+        {
+            c->number = strtod(c->value, &end);
+            c->is_number = len && end == c->value + len;
+        }
+    }
+    f->num_clauses++;
+    return 0;
+}
+
+/* append a path step to the last clause */
+static int jsmn_filter_step_add(
+    jsmn_filter* f, const char* key, size_t len, int index)
+{
+    jsmn_filter_clause* c = &f->clauses[f->num_clauses - 1];
+    jsmn_filter_step* s;
+
+    if(c->depth == JSMN_MAX_DEPTH)
+        return JSMN_ERROR_INVAL;
+    if(!(s = realloc(c->steps, (c->depth + 1) * sizeof(*s))))
+        return JSMN_ERROR_NOMEM;
+    c->steps = s;
+    s += c->depth;
+    s->key = NULL;
+    s->len = len;
+    s->index = index;
+    if(key)
+    {
+        if(!(s->key = malloc(len + 1)))
+            return JSMN_ERROR_NOMEM;
+        memcpy(s->key, key, len);
+        s->key[len] = '\0';
+    }
+    c->depth++;
+    return 0;
+}
+
+/* drop a clause that failed to build */
+static int jsmn_filter_abort(jsmn_filter* f, int error)
+{
+    jsmn_filter_clause* c = &f->clauses[--f->num_clauses];
+    int i;
+
+    for(i=0;i<c->depth;i++)
+        free(c->steps[i].key);
+    free(c->steps);
+    free(c->value);
+    return error;
+}
+
+int jsmn_filter_add(jsmn_filter* f, jsmnfilterop_t op,
+    const char* value, const char* path_format, ...)
+{
+    va_list args;
+    const char* c;
+    char* key;
+    int r = 0;
+
+    if((r = jsmn_filter_begin(f, op, value, value ? strlen(value) : 0)) < 0)
+        return r;
+
+    va_start(args, path_format);
+    for(c=path_format;*c && !r;++c)
+    {
+        if(*c == 'o')
+        {
+            key = va_arg(args, char*);
+            r = jsmn_filter_step_add(f, key, strlen(key), -1);
+        }
+        else if(*c == 'a')
+            r = jsmn_filter_step_add(f, NULL, 0, va_arg(args, int));
+        else
+            r = JSMN_ERROR_INVAL;
+    }
+    va_end(args);
+
+    if(!r && !f->clauses[f->num_clauses - 1].depth)
+        r = JSMN_ERROR_INVAL;
+    return r < 0 ? jsmn_filter_abort(f, r) : 0;
+}
+
+static const char* jsmn_filter_space(const char* c)
+{
+    while(*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n')
+        ++c;
+    return c;
+}
+
+/* end of a quoted string starting at c, or NULL */
+static const char* jsmn_filter_quoted(const char* c)
+{
+    for(++c;*c && *c != '\"';++c)
+        if(*c == '\\' && c[1])
+            ++c;
+    return *c ? c + 1 : NULL;
+}
+
+static int jsmn_filter_compile_clause(jsmn_filter* f, const char** expr)
+{
+    const char *c = jsmn_filter_space(*expr), *path, *value, *e;
+    jsmnfilterop_t op = JSMN_FILTER_EXISTS;
+    char* end;
+    int r, index;
+
+    /* find operator and operand first so the clause can be started */
+    path = c;
+    while(*c && !strchr("=!<>&", *c))
+    {
+        if(*c != '\"')
+            ++c;
+        else if(!(c = jsmn_filter_quoted(c)))
+            return JSMN_ERROR_INVAL;
+    }
+    e = c;
+    if(*c == '=' && c[1] == '=') op = JSMN_FILTER_EQ, c += 2;
+    else if(*c == '!' && c[1] == '=') op = JSMN_FILTER_NE, c += 2;
+    else if(*c == '<' && c[1] == '=') op = JSMN_FILTER_LE, c += 2;
+    else if(*c == '>' && c[1] == '=') op = JSMN_FILTER_GE, c += 2;
+    else if(*c == '<') op = JSMN_FILTER_LT, c += 1;
+    else if(*c == '>') op = JSMN_FILTER_GT, c += 1;
+    else if(*c && *c != '&') return JSMN_ERROR_INVAL;
+
+    value = c = jsmn_filter_space(c);
+    if(op != JSMN_FILTER_EXISTS)
+    {
+        if(*c == '\"')
+        {
+            if(!(c = jsmn_filter_quoted(c)))
+                return JSMN_ERROR_INVAL;
+        }
+        else
+            while(*c && !strchr(" \t\r\n&", *c))
+                ++c;
+    }
+    if((r = jsmn_filter_begin(f, op, value, c - value)) < 0)
+        return r;
+    *expr = c;
+
+    /* path: key, "quoted key", .key or [index] steps */
+    c = path;
+    while(e > c && strchr(" \t\r\n", e[-1]))
+        --e;
+    while(c < e && !r)
+    {
+        if(*c == '.' && c != path)
+            ++c;
+        if(*c == '[')
+        {
+            index = (int)strtol(c + 1, &end, 10);
+            if(end == c + 1 || *end != ']' || index < 0)
+                r = JSMN_ERROR_INVAL;
+            else
+            {
+                r = jsmn_filter_step_add(f, NULL, 0, index);
+                c = end + 1;
+            }
+        }
+        else if(*c == '\"')
+        {
+            value = jsmn_filter_quoted(c);
+            r = jsmn_filter_step_add(f, c + 1, value - c - 2, -1);
+            c = value;
+        }
+        else
+        {
+            value = c;
+            while(c < e && !strchr(".[\"", *c))
+                ++c;
+            if(c == value)
+                r = JSMN_ERROR_INVAL;
+            else
+                r = jsmn_filter_step_add(f, value, c - value, -1);
+        }
+        if(!r && c < e && !strchr(".[\"", *c))
+            r = JSMN_ERROR_INVAL;
+    }
+    if(!r && !f->clauses[f->num_clauses - 1].depth)
+        r = JSMN_ERROR_INVAL;
+    return r < 0 ? jsmn_filter_abort(f, r) : 0;
+}
+
+int jsmn_filter_compile(jsmn_filter* f, const char* expr)
+{
+    int r;
+
+    for(;;)
+    {
+        if((r = jsmn_filter_compile_clause(f, &expr)) < 0)
+            return r;
+        expr = jsmn_filter_space(expr);
+        if(!*expr)
+            return 0;
+        if(expr[0] != '&' || expr[1] != '&')
+            return JSMN_ERROR_INVAL;
+        expr += 2;
+    }
+}
+
+/* scan state while evaluating one record */
+typedef struct {
+    const jsmn_filter* f;
+    const char* js;
+    int depth;
+    uint32_t done; /* bit per satisfied clause */
+    uint32_t all;
+    unsigned char is_object[JSMN_MAX_DEPTH];
+    jsmnint_t key_start[JSMN_MAX_DEPTH];
+    jsmnint_t key_end[JSMN_MAX_DEPTH];
+    int index[JSMN_MAX_DEPTH];
+} jsmn_filter_state;
+
+static int jsmn_filter_path_equals(
+    const jsmn_filter_state* s, const jsmn_filter_clause* c)
+{
+    const jsmn_filter_step* step;
+    int i;
+
+    if(c->depth != s->depth)
+        return 0;
+    /* the last step is the most selective, test it first */
+    for(i=c->depth-1;i>=0;i--)
+    {
+        step = &c->steps[i];
+        if(step->key)
+        {
+            if(!s->is_object[i] ||
+               (size_t)(s->key_end[i] - s->key_start[i]) != step->len ||
+               memcmp(s->js + s->key_start[i], step->key, step->len))
+                return 0;
+        }
+        else if(s->is_object[i] || s->index[i] != step->index)
+            return 0;
+    }
+    return 1;
+}
+
+static int jsmn_filter_eval(const jsmn_filter_clause* c,
+    const char* js, jsmnevent_t event, jsmnint_t start, jsmnint_t end)
+{
+    size_t n = end - start;
+    char num[64], *e;
+    double d;
+    int cmp;
+
+    if(c->op == JSMN_FILTER_EXISTS)
+        return 1;
+    if((event != JSMN_EVENT_STRING && event != JSMN_EVENT_PRIMITIVE) ||
+       (event == JSMN_EVENT_STRING) != (c->value_type == JSMN_STRING))
+        return 0;
+
+    if(c->is_number)
+    {
+        if(n >= sizeof(num))
+            return 0;
+        memcpy(num, js + start, n);
+        num[n] = '\0';
+        d = strtod(num, &e);
+        if(!n || e != num + n)
+            return 0;
+        cmp = (d > c->number) - (d < c->number);
+    }
+    else
+    {
+        cmp = memcmp(js + start, c->value, n < c->value_len ? n : c->value_len);
+        if(!cmp)
+            cmp = (n > c->value_len) - (n < c->value_len);
+    }
+
+    switch(c->op)
+    {
+        case JSMN_FILTER_EQ: return cmp == 0;
+        case JSMN_FILTER_NE: return cmp != 0;
+        case JSMN_FILTER_LT: return cmp < 0;
+        case JSMN_FILTER_LE: return cmp <= 0;
+        case JSMN_FILTER_GT: return cmp > 0;
+        case JSMN_FILTER_GE: return cmp >= 0;
+        default: return 0;
+    }
+}
+
+/* event handler. returns 1 once the record is rejected */
+static int jsmn_filter_event(
+    jsmn_filter_state* s, jsmnevent_t event, jsmnint_t start, jsmnint_t end)
+{
+    const jsmn_filter_clause* c;
+    int i;
+
+    /* accepted, the rest of the record only has to be valid */
+    if(s->done == s->all)
+        return 0;
+
+    switch(event)
+    {
+        case JSMN_EVENT_OBJECT_END: case JSMN_EVENT_ARRAY_END:
+            s->depth--;
+            return 0;
+        case JSMN_EVENT_KEY:
+            s->key_start[s->depth - 1] = start;
+            s->key_end[s->depth - 1] = end;
+            return 0;
+        default:
+            break;
+    }
+
+    if(s->depth && !s->is_object[s->depth - 1])
+        s->index[s->depth - 1]++;
+
+    for(i=0;i<s->f->num_clauses;i++)
+    {
+        c = &s->f->clauses[i];
+        if((s->done & ((uint32_t)1 << i)) || !jsmn_filter_path_equals(s, c))
+            continue;
+        if(!jsmn_filter_eval(c, s->js, event, start, end))
+            return 1;
+        s->done |= (uint32_t)1 << i;
+        if(s->done == s->all)
+            return 0;
+    }
+
+    if(event == JSMN_EVENT_OBJECT_START || event == JSMN_EVENT_ARRAY_START)
+    {
+        s->is_object[s->depth] = event == JSMN_EVENT_OBJECT_START;
+        s->key_start[s->depth] = s->key_end[s->depth] = 0;
+        s->index[s->depth] = -1;
+        s->depth++;
+    }
+    return 0;
+}
+
+#define JSMN_SAX_NAME jsmn_filter_scan
+#define JSMN_SAX_EMIT(state, event, start, end) \
+    jsmn_filter_event((jsmn_filter_state*)(state), event, start, end)
+#include "jsmn_sax.h"
+
+/* 1 match, 0 no match, < 0 if js holds no value */
+static int jsmn_filter_record(
+    const jsmn_filter* f, jsmn_filter_state* s, const char* js, size_t len)
+{
+    jsmnint_t r;
+
+    s->f = f;
+    s->js = js;
+    s->depth = 0;
+    s->done = 0;
+    s->all = f->num_clauses == 32 ? 0xffffffffu :
+        ((uint32_t)1 << f->num_clauses) - 1;
+
+    r = jsmn_filter_scan(js, len, s);
+    if(r == JSMN_ERROR_STOPPED)
+        return 0;
+    if(r <= 0)
+        return r < 0 ? 0 : JSMN_ERROR_PART;
+    return s->done == s->all;
+}
+
+int jsmn_filter_match(const jsmn_filter* f, const char* js, size_t len)
+{
+    jsmn_filter_state s;
+    return jsmn_filter_record(f, &s, js, len) == 1;
+}
+
+int jsmn_filter_next(const jsmn_filter* f, const char* js, size_t len,
+    size_t* pos, size_t* start, size_t* end)
+{
+    jsmn_filter_state s;
+    const char* nl;
+    size_t b, e;
+
+    while(*pos < len)
+    {
+        b = *pos;
+        nl = memchr(js + b, '\n', len - b);
+        e = nl ? (size_t)(nl - js) : len;
+        *pos = nl ? e + 1 : len;
+        if(e > b && js[e - 1] == '\r')
+            --e;
+        if(jsmn_filter_record(f, &s, js + b, e - b) == 1)
+        {
+            *start = b;
+            *end = e;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int jsmn_writer_init(jsmn_writer* w, char* buf, size_t size)
+{
+    memset(w, 0, sizeof(*w));
+    if(!buf)
+    {
+        if(!size)
+            size = 256;
+        if(!(buf = malloc(size)))
+            return JSMN_ERROR_NOMEM;
+        w->owns_buf = 1;
+    }
+    w->buf = buf;
+    w->cap = size;
+    return 0;
+}
+
+void jsmn_writer_destroy(jsmn_writer* w)
+{
+    if(w->owns_buf)
+        free(w->buf);
+}
+
+void jsmn_writer_reset(jsmn_writer* w)
+{
+    w->len = 0;
+    w->error = 0;
+    w->depth = 0;
+    w->after_key = 0;
+}
+
+/* make room for n more bytes */
+static int jsmn_writer_reserve(jsmn_writer* w, size_t n)
+{
+    size_t cap;
+    char* b;
+
+    if(w->len + n <= w->cap)
+        return 0;
+    if(!w->owns_buf)
+        return w->error = JSMN_ERROR_NOMEM;
+    cap = w->cap * 2;
+    if(cap < w->len + n)
+        cap = w->len + n;
+    if(!(b = realloc(w->buf, cap)))
+        return w->error = JSMN_ERROR_NOMEM;
+    w->buf = b;
+    w->cap = cap;
+    return 0;
+}
+
+/* line break and indentation for level. room must be reserved */
+static void jsmn_writer_newline(jsmn_writer* w, int level)
+{
+    w->buf[w->len++] = '\n';
+    memset(w->buf + w->len, ' ', (size_t)w->indent * level);
+    w->len += (size_t)w->indent * level;
+}
+
+/* reserve n bytes plus separators and emit the separators if needed */
+static int jsmn_writer_value(jsmn_writer* w, size_t n)
+{
+    if(w->error ||
+       jsmn_writer_reserve(w, n + 2 + (size_t)w->indent * w->depth))
+        return w->error;
+    if(w->after_key)
+        w->after_key = 0;
+    else if(w->depth)
+    {
+        if(w->has_items[w->depth - 1])
+            w->buf[w->len++] = ',';
+        w->has_items[w->depth - 1] = 1;
+        if(w->indent)
+            jsmn_writer_newline(w, w->depth);
+    }
+    return 0;
+}
+
+static int jsmn_writer_begin(jsmn_writer* w, char c)
+{
+    if(jsmn_writer_value(w, 1))
+        return w->error;
+    if(w->depth == JSMN_MAX_DEPTH)
+        return w->error = JSMN_ERROR_NOMEM;
+    w->buf[w->len++] = c;
+    w->has_items[w->depth++] = 0;
+    return 0;
+}
+
+static int jsmn_writer_end(jsmn_writer* w, char c)
+{
+    if(w->error ||
+       jsmn_writer_reserve(w, 2 + (size_t)w->indent * w->depth))
+        return w->error;
+    if(!w->depth || w->after_key)
+        return w->error = JSMN_ERROR_INVAL;
+    w->depth--;
+    if(w->indent && w->has_items[w->depth])
+        jsmn_writer_newline(w, w->depth);
+    w->buf[w->len++] = c;
+    return 0;
+}
+
+int jsmn_write_object_begin(jsmn_writer* w) { return jsmn_writer_begin(w, '{'); }
+int jsmn_write_object_end(jsmn_writer* w) { return jsmn_writer_end(w, '}'); }
+int jsmn_write_array_begin(jsmn_writer* w) { return jsmn_writer_begin(w, '['); }
+int jsmn_write_array_end(jsmn_writer* w) { return jsmn_writer_end(w, ']'); }
+
+/* 0 copy as is, 'u' needs \u00XX, else the character after the backslash */
+static const char jsmn_escape[256] = {
+    'u','u','u','u','u','u','u','u','b','t','n','u','f','r','u','u',
+    'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+    0, 0,'"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,'\\', 0, 0, 0
+};
+
+/* append s escaped, without quotes. room for len + suffix bytes is
+   reserved and is kept for the suffix the caller writes after s */
+static int jsmn_writer_escape(
+    jsmn_writer* w, const char* s, size_t len, size_t suffix)
+{
+    static const char hex[] = "0123456789abcdef";
+    const char* end = s + len;
+    unsigned char c;
+    size_t run;
+#ifdef JSMN_SSE2
+    __m128i v, quote, slash, ctrl;
+    int mask;
+
+    quote = _mm_set1_epi8('"');
+    slash = _mm_set1_epi8('\\');
+    ctrl = _mm_set1_epi8(0x1f);
+#endif
+
+    while(s < end)
+    {
+#ifdef JSMN_SSE2
+        /* copy 16 byte blocks without special characters */
+        while(end - s >= 16)
+        {
+            v = _mm_loadu_si128((const __m128i*)s);
+            mask = _mm_movemask_epi8(_mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, slash)),
+                _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl), ctrl)));
+            if(mask)
+            {
+                run = 0;
+                while(!(mask & 1))
+                {
+                    mask >>= 1;
+                    run++;
+                }
+                memcpy(w->buf + w->len, s, run);
+                w->len += run;
+                s += run;
+                break;
+            }
+            _mm_storeu_si128((__m128i*)(w->buf + w->len), v);
+            w->len += 16;
+            s += 16;
+        }
+#endif
+        for(run=0;s + run < end && !jsmn_escape[(unsigned char)s[run]];run++)
+            ;
+        memcpy(w->buf + w->len, s, run);
+        w->len += run;
+        s += run;
+        if(s == end)
+            break;
+
+        /* one escaped character. keep room for the rest and the suffix */
+        c = (unsigned char)*s++;
+        if(jsmn_writer_reserve(w, 6 + (end - s) + suffix))
+            return w->error;
+        w->buf[w->len++] = '\\';
+        if(jsmn_escape[c] == 'u')
+        {
+            memcpy(w->buf + w->len, "u00", 3);
+            w->buf[w->len + 3] = hex[c >> 4];
+            w->buf[w->len + 4] = hex[c & 15];
+            w->len += 5;
+        }
+        else
+            w->buf[w->len++] = jsmn_escape[c];
+    }
+    return 0;
+}
+
+int jsmn_write_key(jsmn_writer* w, const char* key, size_t len)
+{
+    if(jsmn_writer_value(w, len + 4))
+        return w->error;
+    w->buf[w->len++] = '"';
+    if(jsmn_writer_escape(w, key, len, w->indent ? 3 : 2))
+        return w->error;
+    w->buf[w->len++] = '"';
+    w->buf[w->len++] = ':';
+    if(w->indent)
+        w->buf[w->len++] = ' ';
+    w->after_key = 1;
+    return 0;
+}
+
+int jsmn_write_string(jsmn_writer* w, const char* s, size_t len)
+{
+    if(jsmn_writer_value(w, len + 2))
+        return w->error;
+    w->buf[w->len++] = '"';
+    if(jsmn_writer_escape(w, s, len, 1))
+        return w->error;
+    w->buf[w->len++] = '"';
+    return 0;
+}
+
+static const char jsmn_digits[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* format v right aligned to the end of buf[20], return first digit */
+static char* jsmn_format_uint64(char* end, uint64_t v)
+{
+    unsigned int d;
+
+    while(v >= 100)
+    {
+        d = (unsigned int)(v % 100) * 2;
+        v /= 100;
+        *--end = jsmn_digits[d + 1];
+        *--end = jsmn_digits[d];
+    }
+    if(v >= 10)
+    {
+        d = (unsigned int)v * 2;
+        *--end = jsmn_digits[d + 1];
+        *--end = jsmn_digits[d];
+    }
+    else
+        *--end = (char)('0' + v);
+    return end;
+}
+
+int jsmn_write_int64(jsmn_writer* w, int64_t value)
+{
+    char tmp[21], *end = tmp + sizeof(tmp), *c;
+    uint64_t v = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+
+    c = jsmn_format_uint64(end, v);
+    if(value < 0)
+        *--c = '-';
+    return jsmn_write_raw(w, c, end - c);
+}
+
+/* shortest double formatting (Schubfach, R. Giulietti). entry k is
+   floor(10^k * 2^(127 - e)) + 1 with e = floor(log2(10^k)), as two
+   64 bit words, high first, for k from -292 to 324 */
+static const uint64_t jsmn_pow10[617][2] = {
+    {0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7BULL}, {0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ADULL},
+    {0xC795830D75038C1DULL, 0xD59DF5B9EF6A2418ULL}, {0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1EULL},
+    {0x9BECCE62836AC577ULL, 0x4EE367F9430AEC33ULL}, {0xC2E801FB244576D5ULL, 0x229C41F793CDA740ULL},
+    {0xF3A20279ED56D48AULL, 0x6B43527578C11110ULL}, {0x9845418C345644D6ULL, 0x830A13896B78AAAAULL},
+    {0xBE5691EF416BD60CULL, 0x23CC986BC656D554ULL}, {0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA9ULL},
+    {0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6AAULL}, {0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC54ULL},
+    {0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF69ULL}, {0x91376C36D99995BEULL, 0x23100809B9C21FA2ULL},
+    {0xB58547448FFFFB2DULL, 0xABD40A0C2832A78BULL}, {0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516DULL},
+    {0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E4ULL}, {0xB1442798F49FFB4AULL, 0x99CD11CFDF41779DULL},
+    {0xDD95317F31C7FA1DULL, 0x40405643D711D584ULL}, {0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2573ULL},
+    {0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EED0ULL}, {0xD863B256369D4A40ULL, 0x90BED43E40076A83ULL},
+    {0x873E4F75E2224E68ULL, 0x5A7744A6E804A292ULL}, {0xA90DE3535AAAE202ULL, 0x711515D0A205CB37ULL},
+    {0xD3515C2831559A83ULL, 0x0D5A5B44CA873E04ULL}, {0x8412D9991ED58091ULL, 0xE858790AFE9486C3ULL},
+    {0xA5178FFF668AE0B6ULL, 0x626E974DBE39A873ULL}, {0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC81290ULL},
+    {0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B9AULL}, {0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E81ULL},
+    {0xC987434744AC874EULL, 0xA327FFB266B56221ULL}, {0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA9ULL},
+    {0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4AAULL}, {0xC4CE17B399107C22ULL, 0xCB550FB4384D21D4ULL},
+    {0xF6019DA07F549B2BULL, 0x7E2A53A146606A49ULL}, {0x99C102844F94E0FBULL, 0x2EDA7444CBFC426EULL},
+    {0xC0314325637A1939ULL, 0xFA911155FEFB5309ULL}, {0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CBULL},
+    {0x96267C7535B763B5ULL, 0x4BC1558B2F3458DFULL}, {0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F17ULL},
+    {0xEA9C227723EE8BCBULL, 0x465E15A979C1CADDULL}, {0x92A1958A7675175FULL, 0x0BFACD89EC191ECAULL},
+    {0xB749FAED14125D36ULL, 0xCEF980EC671F667CULL}, {0xE51C79A85916F484ULL, 0x82B7E12780E7401BULL},
+    {0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908811ULL}, {0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA16ULL},
+    {0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49BULL}, {0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E1ULL},
+    {0xAECC49914078536DULL, 0x58FAE9F773886E19ULL}, {0xDA7F5BF590966848ULL, 0xAF39A475506A899FULL},
+    {0x888F99797A5E012DULL, 0x6D8406C952429604ULL}, {0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B84ULL},
+    {0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A65ULL}, {0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A550680ULL},
+    {0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481FULL}, {0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA27ULL},
+    {0x823C12795DB6CE57ULL, 0x76C53D08D6B70859ULL}, {0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6FULL},
+    {0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD0AULL}, {0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4DULL},
+    {0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DB0ULL}, {0xC6B8E9B0709F109AULL, 0x359AB6419CA1091CULL},
+    {0xF867241C8CC6D4C0ULL, 0xC30163D203C94B63ULL}, {0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1EULL},
+    {0xC21094364DFB5636ULL, 0x985915FC12F542E5ULL}, {0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939EULL},
+    {0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C43ULL}, {0xBD8430BD08277231ULL, 0x50C6FF782A838354ULL},
+    {0xECE53CEC4A314EBDULL, 0xA4F8BF5635246429ULL}, {0x940F4613AE5ED136ULL, 0x871B7795E136BE9AULL},
+    {0xB913179899F68584ULL, 0x28E2557B59846E40ULL}, {0xE757DD7EC07426E5ULL, 0x331AEADA2FE589D0ULL},
+    {0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7622ULL}, {0xB4BCA50B065ABE63ULL, 0x0FED077A756B53AAULL},
+    {0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62895ULL}, {0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95DULL},
+    {0xB080392CC4349DECULL, 0xBD8D794D96AACFB4ULL}, {0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A1ULL},
+    {0x89E42CAAF9491B60ULL, 0xF41686C49DB57245ULL}, {0xAC5D37D5B79B6239ULL, 0x311C2875C522CED6ULL},
+    {0xD77485CB25823AC7ULL, 0x7D633293366B828CULL}, {0x86A8D39EF77164BCULL, 0xAE5DFF9C02033198ULL},
+    {0xA8530886B54DBDEBULL, 0xD9F57F830283FDFDULL}, {0xD267CAA862A12D66ULL, 0xD072DF63C324FD7CULL},
+    {0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6EULL}, {0xA46116538D0DEB78ULL, 0x52D9BE85F074E609ULL},
+    {0xCD795BE870516656ULL, 0x67902E276C921F8CULL}, {0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B7ULL},
+    {0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A5ULL}, {0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CEULL},
+    {0xFAD2A4B13D1B5D6CULL, 0x796B805720085F82ULL}, {0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB1ULL},
+    {0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9DULL}, {0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D45ULL},
+    {0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4BULL}, {0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635EULL},
+    {0xEF340A98172AACE4ULL, 0x86FB897116C87C35ULL}, {0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA1ULL},
+    {0xBAE0A846D2195712ULL, 0x8974836059CCA10AULL}, {0xE998D258869FACD7ULL, 0x2BD1A438703FC94CULL},
+    {0x91FF83775423CC06ULL, 0x7B6306A34627DDD0ULL}, {0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D543ULL},
+    {0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A94ULL}, {0x8E938662882AF53EULL, 0x547EB47B7282EE9DULL},
+    {0xB23867FB2A35B28DULL, 0xE99E619A4F23AA44ULL}, {0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D5ULL},
+    {0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD05ULL}, {0xAE0B158B4738705EULL, 0x9624AB50B148D446ULL},
+    {0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0958ULL}, {0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D7ULL},
+    {0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4DULL}, {0xD47487CC8470652BULL, 0x7647C32000696720ULL},
+    {0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E074ULL}, {0xA5FB0A17C777CF09ULL, 0xF468107100525891ULL},
+    {0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB5ULL}, {0x81AC1FE293D599BFULL, 0xC6F14CD848405531ULL},
+    {0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7DULL}, {0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851DULL},
+    {0xFD442E4688BD304AULL, 0x908F4A166D1DA664ULL}, {0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FFULL},
+    {0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FEULL}, {0xF7549530E188C128ULL, 0xD12BEE59E68EF47DULL},
+    {0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CFULL}, {0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF02ULL},
+    {0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC2ULL}, {0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0BAULL},
+    {0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E8ULL}, {0xEBDF661791D60F56ULL, 0x111B495B3464AD22ULL},
+    {0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC35ULL}, {0xB84687C269EF3BFBULL, 0x3D5D514F40EEA743ULL},
+    {0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5113ULL}, {0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ACULL},
+    {0xB3F4E093DB73A093ULL, 0x59ED216765690F57ULL}, {0xE0F218B8D25088B8ULL, 0x306869C13EC3532DULL},
+    {0x8C974F7383725573ULL, 0x1E414218C73A13FCULL}, {0xAFBD2350644EEACFULL, 0xE5D1929EF90898FBULL},
+    {0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF3AULL}, {0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB784ULL},
+    {0xAB9EB47C81F5114FULL, 0x066EA92F3F326565ULL}, {0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBEULL},
+    {0x8613FD0145877585ULL, 0xBD06742CE95F5F37ULL}, {0xA798FC4196E952E7ULL, 0x2C48113823B73705ULL},
+    {0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C6ULL}, {0x82EF85133DE648C4ULL, 0x9A984D73DBE722FCULL},
+    {0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBBULL}, {0xCC963FEE10B7D1B3ULL, 0x318DF905079926A9ULL},
+    {0xFFBBCFE994E5C61FULL, 0xFDF17746497F7053ULL}, {0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA634ULL},
+    {0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC1ULL}, {0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B1ULL},
+    {0x9C1661A651213E2DULL, 0x06BEA10CA65C084FULL}, {0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A63ULL},
+    {0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFBULL}, {0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01DULL},
+    {0xBE89523386091465ULL, 0xF6BBB397F1135824ULL}, {0xEE2BA6C0678B597FULL, 0x746AA07DED582E2DULL},
+    {0x94DB483840B717EFULL, 0xA8C2A44EB4571CDDULL}, {0xBA121A4650E4DDEBULL, 0x92F34D62616CE414ULL},
+    {0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D18ULL}, {0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122FULL},
+    {0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BBULL}, {0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C6AULL},
+    {0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C2ULL}, {0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB3ULL},
+    {0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDFULL}, {0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96CULL},
+    {0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C7ULL}, {0xD89D64D57A607744ULL, 0xE871C7BF077BA8B8ULL},
+    {0x87625F056C7C4A8BULL, 0x11471CD764AD4973ULL}, {0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BD0ULL},
+    {0xD389B47879823479ULL, 0x4AFF1D108D4EC2C4ULL}, {0x843610CB4BF160CBULL, 0xCEDF722A585139BBULL},
+    {0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658829ULL}, {0xCE947A3DA6A9273EULL, 0x733D226229FEEA33ULL},
+    {0x811CCC668829B887ULL, 0x0806357D5A3F5260ULL}, {0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F8ULL},
+    {0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B6ULL}, {0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE3ULL},
+    {0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0EULL}, {0xC5029163F384A931ULL, 0x0A9E795E65D4DF12ULL},
+    {0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D6ULL}, {0x99EA0196163FA42EULL, 0x504BCED1BF8E4E46ULL},
+    {0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D7ULL}, {0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4DULL},
+    {0x964E858C91BA2655ULL, 0x3A6A07F8D510F870ULL}, {0xBBE226EFB628AFEAULL, 0x890489F70A55368CULL},
+    {0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842FULL}, {0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929EULL},
+    {0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173745ULL}, {0xE55990879DDCAABDULL, 0xCC420A6A101D0516ULL},
+    {0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232EULL}, {0xB32DF8E9F3546564ULL, 0x47939822DC96ABFAULL},
+    {0xDFF9772470297EBDULL, 0x59787E2B93BC56F8ULL}, {0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65BULL},
+    {0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F2ULL}, {0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEEULL},
+    {0x88B402F7FD75539BULL, 0x11DBCB0218EBB415ULL}, {0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A11AULL},
+    {0xD59944A37C0752A2ULL, 0x4BE76D3346F04960ULL}, {0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDCULL},
+    {0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB953ULL}, {0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A8ULL},
+    {0x825ECC24C873782FULL, 0x8ED400668C0C28C9ULL}, {0xA2F67F2DFA90563BULL, 0x728900802F0F32FBULL},
+    {0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFBAULL}, {0xFEA126B7D78186BCULL, 0xE2F610C84987BFA9ULL},
+    {0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7CAULL}, {0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBCULL},
+    {0xF8A95FCF88747D94ULL, 0x75A44C6397CE912BULL}, {0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABBULL},
+    {0xC24452DA229B021BULL, 0xFBE85BADCE996169ULL}, {0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C4ULL},
+    {0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41BULL}, {0xBDB6B8E905CB600FULL, 0x5400E987BBC1C921ULL},
+    {0xED246723473E3813ULL, 0x290123E9AAB23B69ULL}, {0x9436C0760C86E30BULL, 0xF9A0B6720AAF6522ULL},
+    {0xB94470938FA89BCEULL, 0xF808E40E8D5B3E6AULL}, {0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E05ULL},
+    {0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C3ULL}, {0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF4ULL},
+    {0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B1ULL}, {0x8D590723948A535FULL, 0x579C487E5A38AD0FULL},
+    {0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D852ULL}, {0xDCDB1B2798182244ULL, 0xF8E431456CF88E66ULL},
+    {0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B5900ULL}, {0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F40ULL},
+    {0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB10ULL}, {0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4EAULL},
+    {0xA87FEA27A539E9A5ULL, 0x3F2398D747B36225ULL}, {0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AAEULL},
+    {0x83A3EEEEF9153E89ULL, 0x1953CF68300424ADULL}, {0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD8ULL},
+    {0xCDB02555653131B6ULL, 0x3792F412CB06794EULL}, {0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD1ULL},
+    {0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC5ULL}, {0xC8DE047564D20A8BULL, 0xF245825A5A445276ULL},
+    {0xFB158592BE068D2EULL, 0xEED6E2F0F0D56713ULL}, {0x9CED737BB6C4183DULL, 0x55464DD69685606CULL},
+    {0xC428D05AA4751E4CULL, 0xAA97E14C3C26B887ULL}, {0xF53304714D9265DFULL, 0xD53DD99F4B3066A9ULL},
+    {0x993FE2C6D07B7FABULL, 0xE546A8038EFE402AULL}, {0xBF8FDB78849A5F96ULL, 0xDE98520472BDD034ULL},
+    {0xEF73D256A5C0F77CULL, 0x963E66858F6D4441ULL}, {0x95A8637627989AADULL, 0xDDE7001379A44AA9ULL},
+    {0xBB127C53B17EC159ULL, 0x5560C018580D5D53ULL}, {0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A7ULL},
+    {0x9226712162AB070DULL, 0xCAB3961304CA70E9ULL}, {0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D23ULL},
+    {0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506BULL}, {0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB243ULL},
+    {0xB267ED1940F1C61CULL, 0x55F038B237591ED4ULL}, {0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6689ULL},
+    {0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA016ULL}, {0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081BULL},
+    {0xD9C7DCED53C72255ULL, 0x96E7BD358C904A22ULL}, {0x881CEA14545C7575ULL, 0x7E50D64177DA2E55ULL},
+    {0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9EAULL}, {0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E865ULL},
+    {0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113FULL}, {0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58FULL},
+    {0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF3ULL}, {0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED8ULL},
+    {0xA2425FF75E14FC31ULL, 0xA1258379A94D028EULL}, {0xCAD2F7F5359A3B3EULL, 0x096EE45813A04331ULL},
+    {0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FDULL}, {0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL},
+    {0xC612062576589DDAULL, 0x95364AFE032A819EULL}, {0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL},
+    {0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL}, {0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL},
+    {0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL}, {0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL},
+    {0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL}, {0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL},
+    {0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL}, {0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL},
+    {0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL}, {0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL},
+    {0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL}, {0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL},
+    {0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL}, {0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL},
+    {0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL}, {0x89705F4136B4A597ULL, 0x31680A88F8953031ULL},
+    {0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL}, {0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL},
+    {0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL}, {0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL},
+    {0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL}, {0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL},
+    {0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL}, {0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL},
+    {0x8000000000000000ULL, 0x0000000000000001ULL}, {0xA000000000000000ULL, 0x0000000000000001ULL},
+    {0xC800000000000000ULL, 0x0000000000000001ULL}, {0xFA00000000000000ULL, 0x0000000000000001ULL},
+    {0x9C40000000000000ULL, 0x0000000000000001ULL}, {0xC350000000000000ULL, 0x0000000000000001ULL},
+    {0xF424000000000000ULL, 0x0000000000000001ULL}, {0x9896800000000000ULL, 0x0000000000000001ULL},
+    {0xBEBC200000000000ULL, 0x0000000000000001ULL}, {0xEE6B280000000000ULL, 0x0000000000000001ULL},
+    {0x9502F90000000000ULL, 0x0000000000000001ULL}, {0xBA43B74000000000ULL, 0x0000000000000001ULL},
+    {0xE8D4A51000000000ULL, 0x0000000000000001ULL}, {0x9184E72A00000000ULL, 0x0000000000000001ULL},
+    {0xB5E620F480000000ULL, 0x0000000000000001ULL}, {0xE35FA931A0000000ULL, 0x0000000000000001ULL},
+    {0x8E1BC9BF04000000ULL, 0x0000000000000001ULL}, {0xB1A2BC2EC5000000ULL, 0x0000000000000001ULL},
+    {0xDE0B6B3A76400000ULL, 0x0000000000000001ULL}, {0x8AC7230489E80000ULL, 0x0000000000000001ULL},
+    {0xAD78EBC5AC620000ULL, 0x0000000000000001ULL}, {0xD8D726B7177A8000ULL, 0x0000000000000001ULL},
+    {0x878678326EAC9000ULL, 0x0000000000000001ULL}, {0xA968163F0A57B400ULL, 0x0000000000000001ULL},
+    {0xD3C21BCECCEDA100ULL, 0x0000000000000001ULL}, {0x84595161401484A0ULL, 0x0000000000000001ULL},
+    {0xA56FA5B99019A5C8ULL, 0x0000000000000001ULL}, {0xCECB8F27F4200F3AULL, 0x0000000000000001ULL},
+    {0x813F3978F8940984ULL, 0x4000000000000001ULL}, {0xA18F07D736B90BE5ULL, 0x5000000000000001ULL},
+    {0xC9F2C9CD04674EDEULL, 0xA400000000000001ULL}, {0xFC6F7C4045812296ULL, 0x4D00000000000001ULL},
+    {0x9DC5ADA82B70B59DULL, 0xF020000000000001ULL}, {0xC5371912364CE305ULL, 0x6C28000000000001ULL},
+    {0xF684DF56C3E01BC6ULL, 0xC732000000000001ULL}, {0x9A130B963A6C115CULL, 0x3C7F400000000001ULL},
+    {0xC097CE7BC90715B3ULL, 0x4B9F100000000001ULL}, {0xF0BDC21ABB48DB20ULL, 0x1E86D40000000001ULL},
+    {0x96769950B50D88F4ULL, 0x1314448000000001ULL}, {0xBC143FA4E250EB31ULL, 0x17D955A000000001ULL},
+    {0xEB194F8E1AE525FDULL, 0x5DCFAB0800000001ULL}, {0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000001ULL},
+    {0xB7ABC627050305ADULL, 0xF14A3D9E40000001ULL}, {0xE596B7B0C643C719ULL, 0x6D9CCD05D0000001ULL},
+    {0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000001ULL}, {0xB35DBF821AE4F38BULL, 0xDDA2802C8A800001ULL},
+    {0xE0352F62A19E306EULL, 0xD50B2037AD200001ULL}, {0x8C213D9DA502DE45ULL, 0x4526F422CC340001ULL},
+    {0xAF298D050E4395D6ULL, 0x9670B12B7F410001ULL}, {0xDAF3F04651D47B4CULL, 0x3C0CDD765F114001ULL},
+    {0x88D8762BF324CD0FULL, 0xA5880A69FB6AC801ULL}, {0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A01ULL},
+    {0xD5D238A4ABE98068ULL, 0x72A4904598D6D881ULL}, {0x85A36366EB71F041ULL, 0x47A6DA2B7F864751ULL},
+    {0xA70C3C40A64E6C51ULL, 0x999090B65F67D925ULL}, {0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6EULL},
+    {0x82818F1281ED449FULL, 0xBFF8F10E7A8921A5ULL}, {0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0EULL},
+    {0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764491ULL}, {0xFEE50B7025C36A08ULL, 0x02F236D04753D5B5ULL},
+    {0x9F4F2726179A2245ULL, 0x01D762422C946591ULL}, {0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF6ULL},
+    {0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB3ULL}, {0x9B934C3B330C8577ULL, 0x63CC55F49F88EB30ULL},
+    {0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FCULL}, {0xF316271C7FC3908AULL, 0x8BEF464E3945EF7BULL},
+    {0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ADULL}, {0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA318ULL},
+    {0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDEULL}, {0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6BULL},
+    {0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B45ULL}, {0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B617ULL},
+    {0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CEULL}, {0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE42ULL},
+    {0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD2ULL}, {0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA3ULL},
+    {0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCCULL}, {0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBFULL},
+    {0x8A2DBF142DFCC7ABULL, 0x6E3569326C784338ULL}, {0xACB92ED9397BF996ULL, 0x49C2C37F07965405ULL},
+    {0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE907ULL}, {0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A4ULL},
+    {0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0DULL}, {0xD2D80DB02AABD62BULL, 0xF50A3FA490C30191ULL},
+    {0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FBULL}, {0xA4B8CAB1A1563F52ULL, 0x577001B891185939ULL},
+    {0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F87ULL}, {0x80B05E5AC60B6178ULL, 0x544F8158315B05B5ULL},
+    {0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C722ULL}, {0xC913936DD571C84CULL, 0x03BC3A19CD1E38EAULL},
+    {0xFB5878494ACE3A5FULL, 0x04AB48A04065C724ULL}, {0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C77ULL},
+    {0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8395ULL}, {0xF5746577930D6500ULL, 0xCA8F44EC7EE3647AULL},
+    {0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECCULL}, {0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67FULL},
+    {0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101FULL}, {0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A13ULL},
+    {0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC98ULL}, {0xEA1575143CF97226ULL, 0xF52D09D71A3293BEULL},
+    {0x924D692CA61BE758ULL, 0x593C2626705F9C57ULL}, {0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836DULL},
+    {0xE498F455C38B997AULL, 0x0B6DFB9C0F956448ULL}, {0x8EDF98B59A373FECULL, 0x4724BD4189BD5EADULL},
+    {0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB658ULL}, {0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EEULL},
+    {0x8B865B215899F46CULL, 0xBD79E0D20082EE75ULL}, {0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA12ULL},
+    {0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9496ULL}, {0x884134FE908658B2ULL, 0x3109058D147FDCDEULL},
+    {0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD416ULL}, {0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91BULL},
+    {0x850FADC09923329EULL, 0x03E2CF6BC604DDB1ULL}, {0xA6539930BF6BFF45ULL, 0x84DB8346B786151DULL},
+    {0xCFE87F7CEF46FF16ULL, 0xE612641865679A64ULL}, {0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07FULL},
+    {0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09EULL}, {0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC6ULL},
+    {0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F7ULL}, {0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFBULL},
+    {0xC646D63501A1511DULL, 0xB281E1FD541501B9ULL}, {0xF7D88BC24209A565ULL, 0x1F225A7CA91A4227ULL},
+    {0x9AE757596946075FULL, 0x3375788DE9B06959ULL}, {0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AFULL},
+    {0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49BULL}, {0x9745EB4D50CE6332ULL, 0xF840B7BA963646E1ULL},
+    {0xBD176620A501FBFFULL, 0xB650E5A93BC3D899ULL}, {0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBFULL},
+    {0x93BA47C980E98CDFULL, 0xC66F336C36B10138ULL}, {0xB8A8D9BBE123F017ULL, 0xB80B0047445D4185ULL},
+    {0xE6D3102AD96CEC1DULL, 0xA60DC059157491E6ULL}, {0x9043EA1AC7E41392ULL, 0x87C89837AD68DB30ULL},
+    {0xB454E4A179DD1877ULL, 0x29BABE4598C311FCULL}, {0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67BULL},
+    {0x8CE2529E2734BB1DULL, 0x1899E4A65F58660DULL}, {0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F90ULL},
+    {0xDC21A1171D42645DULL, 0x76707543F4FA1F74ULL}, {0x899504AE72497EBAULL, 0x6A06494A791C53A9ULL},
+    {0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636893ULL}, {0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B7ULL},
+    {0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B3ULL}, {0xA7F26836F282B732ULL, 0x8E6CAC7768D7141FULL},
+    {0xD1EF0244AF2364FFULL, 0x3207D795430CD927ULL}, {0x8335616AED761F1FULL, 0x7F44E6BD49E807B9ULL},
+    {0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A7ULL}, {0xCD036837130890A1ULL, 0x36DBA887C37A8C10ULL},
+    {0x802221226BE55A64ULL, 0xC2494954DA2C978AULL}, {0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6DULL},
+    {0xC83553C5C8965D3DULL, 0x6F92829494E5ACC8ULL}, {0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17FAULL},
+    {0x9C69A97284B578D7ULL, 0xFF2A760414536EFCULL}, {0xC38413CF25E2D70DULL, 0xFEF5138519684ABBULL},
+    {0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D6AULL}, {0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A62ULL},
+    {0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FBULL}, {0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF39ULL},
+    {0x952AB45CFA97A0B2ULL, 0xDD945A747BF26184ULL}, {0xBA756174393D88DFULL, 0x94F971119AEEF9E5ULL},
+    {0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85EULL}, {0x91ABB422CCB812EEULL, 0xAC62E055C10AB33BULL},
+    {0xB616A12B7FE617AAULL, 0x577B986B314D600AULL}, {0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80CULL},
+    {0x8E41ADE9FBEBC27DULL, 0x14588F13BE847308ULL}, {0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC9ULL},
+    {0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BCULL}, {0x8AEC23D680043BEEULL, 0x25DE7BB9480D5855ULL},
+    {0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6BULL}, {0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA05ULL},
+    {0x87AA9AFF79042286ULL, 0x90FB44D2F05D0843ULL}, {0xA99541BF57452B28ULL, 0x353A1607AC744A54ULL},
+    {0xD3FA922F2D1675F2ULL, 0x42889B8997915CE9ULL}, {0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA12ULL},
+    {0xA59BC234DB398C25ULL, 0x43FAB9837E699096ULL}, {0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BCULL},
+    {0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F6ULL}, {0xA1BA1BA79E1632DCULL, 0x6462D92A69731733ULL},
+    {0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFFULL}, {0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43FULL},
+    {0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A8ULL}, {0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD1ULL},
+    {0xF6C69A72A3989F5BULL, 0x8AAD549E57273D46ULL}, {0x9A3C2087A63F6399ULL, 0x36AC54E2F678864CULL},
+    {0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DEULL}, {0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D6ULL},
+    {0x969EB7C47859E743ULL, 0x9F644AE5A4B1B326ULL}, {0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEFULL},
+    {0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EBULL}, {0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F3ULL},
+    {0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB30ULL}, {0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FBULL},
+    {0x8FA475791A569D10ULL, 0xF96E017D694487BDULL}, {0xB38D92D760EC4455ULL, 0x37C981DCC395A9ADULL},
+    {0xE070F78D3927556AULL, 0x85BBE253F47B1418ULL}, {0x8C469AB843B89562ULL, 0x93956D7478CCEC8FULL},
+    {0xAF58416654A6BABBULL, 0x387AC8D1970027B3ULL}, {0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319FULL},
+    {0x88FCF317F22241E2ULL, 0x441FECE3BDF81F04ULL}, {0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C4ULL},
+    {0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B075ULL}, {0x85C7056562757456ULL, 0xF6872D5667844E4AULL},
+    {0xA738C6BEBB12D16CULL, 0xB428F8AC016561DCULL}, {0xD106F86E69D785C7ULL, 0xE13336D701BEBA53ULL},
+    {0x82A45B450226B39CULL, 0xECC0024661173474ULL}, {0xA34D721642B06084ULL, 0x27F002D7F95D0191ULL},
+    {0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F5ULL}, {0xFF290242C83396CEULL, 0x7E67047175A15272ULL},
+    {0x9F79A169BD203E41ULL, 0x0F0062C6E984D387ULL}, {0xC75809C42C684DD1ULL, 0x52C07B78A3E60869ULL},
+    {0xF92E0C3537826145ULL, 0xA7709A56CCDF8A83ULL}, {0x9BBCC7A142B17CCBULL, 0x88A66076400BB692ULL},
+    {0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA436ULL}, {0xF356F7EBF83552FEULL, 0x0583F6B8C4124D44ULL},
+    {0x98165AF37B2153DEULL, 0xC3727A337A8B704BULL}, {0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5DULL},
+    {0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF74ULL}, {0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA9ULL},
+    {0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173693ULL}, {0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0438ULL},
+    {0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A3ULL}, {0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4CULL},
+    {0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61EULL}, {0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D3ULL},
+    {0xB10D8E1456105DADULL, 0x7425A83E872C5F48ULL}, {0xDD50F1996B947518ULL, 0xD12F124E28F7771AULL},
+    {0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA70ULL}, {0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550CULL},
+    {0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4FULL}, {0x8714A775E3E95C78ULL, 0x65ACFAEC34810A72ULL},
+    {0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0EULL}, {0xD31045A8341CA07CULL, 0x1EDE48111209A051ULL},
+    {0x83EA2B892091E44DULL, 0x934AED0AAB460433ULL}, {0xA4E4B66B68B65D60ULL, 0xF81DA84D56178540ULL},
+    {0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668FULL}, {0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B42601AULL},
+    {0xA1075A24E4421730ULL, 0xB24CF65B8612F820ULL}, {0xC94930AE1D529CFCULL, 0xDEE033F26797B628ULL},
+    {0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B2ULL}, {0x9D412E0806E88AA5ULL, 0x8E1F289560EE864FULL},
+    {0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E3ULL}, {0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DCULL},
+    {0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF2AULL}, {0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF4ULL},
+    {0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B1ULL}, {0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98FULL},
+    {0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F2ULL}, {0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EEULL},
+    {0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB5ULL}, {0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A2ULL},
+    {0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334BULL}, {0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400FULL},
+    {0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511013ULL}, {0xDF78E4B2BD342CF6ULL, 0x914DA9246B255417ULL},
+    {0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548FULL}, {0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B2ULL},
+    {0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741FULL}, {0x8865899617FB1871ULL, 0x7E2FA67C7A658893ULL},
+    {0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB8ULL}, {0xD51EA6FA85785631ULL, 0x552A74227F3EA566ULL},
+    {0x8533285C936B35DEULL, 0xD53A88958F872760ULL}, {0xA67FF273B8460356ULL, 0x8A892ABAF368F138ULL},
+    {0xD01FEF10A657842CULL, 0x2D2B7569B0432D86ULL}, {0x8213F56A67F6B29BULL, 0x9C3B29620E29FC74ULL},
+    {0xA298F2C501F45F42ULL, 0x8349F3BA91B47B90ULL}, {0xCB3F2F7642717713ULL, 0x241C70A936219A74ULL},
+    {0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0111ULL}, {0x9EC95D1463E8A506ULL, 0xF4363804324A40ABULL},
+    {0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D6ULL}, {0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050BULL},
+    {0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8327ULL}, {0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F1ULL},
+    {0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CEDULL}, {0x976E41088617CA01ULL, 0xD5BE0503E085D814ULL},
+    {0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E19ULL}, {0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219FULL},
+    {0x93E1AB8252F33B45ULL, 0xCABB90E5C942B504ULL}, {0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936244ULL},
+    {0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD5ULL}, {0x906A617D450187E2ULL, 0x27FB2B80668B24C6ULL},
+    {0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF7ULL}, {0xE1A63853BBD26451ULL, 0x5E7873F8A0396974ULL},
+    {0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E9ULL}, {0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA63ULL},
+    {0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FCULL}, {0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9EULL},
+    {0xAC2820D9623BF429ULL, 0x546345FA9FBDCD45ULL}, {0xD732290FBACAF133ULL, 0xA97C177947AD4096ULL},
+    {0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485EULL}, {0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A75ULL},
+    {0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3112ULL}, {0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EACULL},
+    {0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E56ULL}, {0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35ECULL},
+    {0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B4ULL}, {0xA0555E361951C366ULL, 0xD7E105BCC3326220ULL},
+    {0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA8ULL}, {0xFA856334878FC150ULL, 0xB14F98F6F0FEB952ULL},
+    {0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D4ULL}, {0xC3B8358109E84F07ULL, 0x0A862F80EC4700C9ULL},
+    {0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FBULL}, {0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789DULL},
+    {0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C4ULL}, {0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC75ULL},
+    {0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC9ULL}, {0xBAA718E68396CFFDULL, 0xD30560258F54E6BBULL},
+    {0xE950DF20247C83FDULL, 0x47C6B82EF32A206AULL}, {0x91D28B7416CDD27EULL, 0x4CDC331D57FA5442ULL},
+    {0xB6472E511C81471DULL, 0xE0133FE4ADF8E953ULL}, {0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A7ULL},
+    {0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7649ULL}, {0xB201833B35D63F73ULL, 0x2CD2CC6551E513DBULL},
+    {0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D2ULL}, {0x8B112E86420F6191ULL, 0xFB04AFAF27FAF783ULL},
+    {0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B564ULL}, {0xD94AD8B1C7380874ULL, 0x18375281AE7822BDULL},
+    {0x87CEC76F1C830548ULL, 0x8F2293910D0B15B6ULL}, {0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB23ULL},
+    {0xD433179D9C8CB841ULL, 0x5FA60692A46151ECULL}, {0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD334ULL},
+    {0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0801ULL}, {0xCF39E50FEAE16BEFULL, 0xD768226B34870A01ULL},
+    {0x81842F29F2CCE375ULL, 0xE6A1158300D46641ULL}, {0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD1ULL},
+    {0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC5ULL}, {0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B6ULL},
+    {0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D2ULL}
+};
+
+#ifndef __SIZEOF_INT128__
+/* 64x64 bit product, returns the low word */
+static uint64_t jsmn_mul64(uint64_t a, uint64_t b, uint64_t* hi)
+{
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+    uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+
+    *hi = a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t)p00;
+}
+#endif
+
+/* (g * cp) >> 128 rounded to odd */
+static uint64_t jsmn_round_to_odd(const uint64_t* g, uint64_t cp)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 x = (unsigned __int128)g[1] * cp;
+    unsigned __int128 y = (unsigned __int128)g[0] * cp + (uint64_t)(x >> 64);
+    return (uint64_t)(y >> 64) | ((uint64_t)y > 1);
+#else
+    uint64_t xh, yh, yl;
+
+    jsmn_mul64(g[1], cp, &xh);
+    yl = jsmn_mul64(g[0], cp, &yh) + xh;
+    yh += yl < xh;
+    return yh | (yl > 1);
+#endif
+}
+
+/* shortest digits * 10^exp10 that reads back as the positive, finite,
+   non zero double with significand bits f and biased exponent be */
+static uint64_t jsmn_shortest(uint64_t f, int be, int* exp10)
+{
+    uint64_t c, cb, vbl, vb, vbr, lower, upper, s, sp;
+    const uint64_t* g;
+    int q, k, h, odd, closer, uin, win;
+
+    c = be ? f | (uint64_t)1 << 52 : f;
+    q = be ? be - 1075 : -1074;
+    odd = (int)(c & 1);
+    /* the gap below a power of two is half the gap above it */
+    closer = f == 0 && be > 1;
+
+    /* k = floor(log10(2^q)) or floor(log10(3/4 2^q)) if closer,
+       h = q + floor(log2(10^-k)) + 1 */
+    k = (q * 1262611 - (closer ? 524031 : 0)) >> 22;
+    h = q + ((-k * 1741647) >> 19) + 1;
+    g = jsmn_pow10[-k + 292];
+
+    cb = c << 2;
+    vbl = jsmn_round_to_odd(g, (cb - 2 + closer) << h);
+    vb = jsmn_round_to_odd(g, cb << h);
+    vbr = jsmn_round_to_odd(g, (cb + 2) << h);
+    lower = vbl + odd;
+    upper = vbr - odd;
+
+    /* one digit less if exactly one of the neighbours is in range */
+    s = vb >> 2;
+    if(s >= 10)
+    {
+        sp = s / 10;
+        uin = lower <= 40 * sp;
+        win = 40 * sp + 40 <= upper;
+        if(uin != win)
+        {
+            *exp10 = k + 1;
+            return sp + win;
+        }
+    }
+    uin = lower <= 4 * s;
+    win = 4 * s + 4 <= upper;
+    *exp10 = k;
+    if(uin != win)
+        return s + win;
+    /* both or none, take the closer one */
+    return s + (vb > 4 * s + 2 || (vb == 4 * s + 2 && (s & 1)));
+}
+
+int jsmn_write_double(jsmn_writer* w, double value)
+{
+    char tmp[32], digits[20], *d, *c = tmp;
+    uint64_t bits, m;
+    int n, x, i;
+
+    if(value != value || value - value != 0)
+        return jsmn_write_null(w);
+
+    /* integral values print exactly with the integer path */
+    if(value >= -9007199254740992.0 && value <= 9007199254740992.0 &&
+       value == (double)(int64_t)value && (value != 0 || 1 / value > 0))
+        return jsmn_write_int64(w, (int64_t)value);
+
+    memcpy(&bits, &value, sizeof(bits));
+    if(bits >> 63)
+        *c++ = '-';
+    if(!(bits << 1))
+    {
+        *c++ = '0';
+        return jsmn_write_raw(w, tmp, c - tmp);
+    }
+
+    m = jsmn_shortest(bits & (((uint64_t)1 << 52) - 1),
+        (int)(bits >> 52) & 0x7ff, &x);
+    while(m % 10 == 0)
+    {
+        m /= 10;
+        x++;
+    }
+    d = jsmn_format_uint64(digits + sizeof(digits), m);
+    n = (int)(digits + sizeof(digits) - d);
+    /* exponent of the first digit */
+    x += n - 1;
+
+    /* like %.17g but without padding the exponent */
+    if(x < -4 || x >= 17)
+    {
+        *c++ = d[0];
+        if(n > 1)
+        {
+            *c++ = '.';
+            memcpy(c, d + 1, n - 1);
+            c += n - 1;
+        }
+        *c++ = 'e';
+        *c++ = x < 0 ? '-' : '+';
+        x = x < 0 ? -x : x;
+        if(x >= 100)
+            *c++ = (char)('0' + x / 100);
+        if(x >= 10)
+            *c++ = (char)('0' + x / 10 % 10);
+        *c++ = (char)('0' + x % 10);
+    }
+    else if(x < 0)
+    {
+        *c++ = '0';
+        *c++ = '.';
+        for(i=-1;i>x;i--)
+            *c++ = '0';
+        memcpy(c, d, n);
+        c += n;
+    }
+    else
+    {
+        for(i=0;i<n || i<=x;i++)
+        {
+            if(i == x + 1)
+                *c++ = '.';
+            *c++ = i < n ? d[i] : '0';
+        }
+    }
+    return jsmn_write_raw(w, tmp, c - tmp);
+}
+
+int jsmn_write_bool(jsmn_writer* w, int value)
+{
+    return value ? jsmn_write_raw(w, "true", 4) : jsmn_write_raw(w, "false", 5);
+}
+
+int jsmn_write_null(jsmn_writer* w)
+{
+    return jsmn_write_raw(w, "null", 4);
+}
+
+int jsmn_write_raw(jsmn_writer* w, const char* text, size_t len)
+{
+    if(jsmn_writer_value(w, len))
+        return w->error;
+    memcpy(w->buf + w->len, text, len);
+    w->len += len;
+    return 0;
+}
+
+/* write already escaped string text with quotes, as a key or a value */
+static int jsmn_writer_quoted(
+    jsmn_writer* w, const char* text, size_t len, int key)
+{
+    if(jsmn_writer_value(w, len + 4))
+        return w->error;
+    w->buf[w->len++] = '"';
+    memcpy(w->buf + w->len, text, len);
+    w->len += len;
+    w->buf[w->len++] = '"';
+    if(key)
+    {
+        w->buf[w->len++] = ':';
+        if(w->indent)
+            w->buf[w->len++] = ' ';
+        w->after_key = 1;
+    }
+    return 0;
+}
+
+/* write a key or value token. returns tokens consumed */
+static jsmnint_t jsmn_transcode_token(
+    const char* js, jsmntok_t* t, jsmn_writer* w, int key)
+{
+    jsmnint_t i, j, r;
+
+    switch(t->type)
+    {
+        case JSMN_OBJECT: case JSMN_ARRAY:
+            if(jsmn_writer_begin(w, t->type == JSMN_OBJECT ? '{' : '['))
+                return w->error;
+            for(i=0,j=1;i<t->size;i++)
+            {
+                if(t->type == JSMN_OBJECT)
+                {
+                    if((r = jsmn_transcode_token(js, t + j, w, 1)) < 0)
+                        return r;
+                    j += r;
+                }
+                if((r = jsmn_transcode_token(js, t + j, w, 0)) < 0)
+                    return r;
+                j += r;
+            }
+            if(jsmn_writer_end(w, t->type == JSMN_OBJECT ? '}' : ']'))
+                return w->error;
+            return j;
+        case JSMN_STRING:
+            if(jsmn_writer_quoted(w, js + t->start, t->end - t->start, key))
+                return w->error;
+            return 1;
+        default:
+            if(key)
+                r = jsmn_writer_quoted(w, js + t->start, t->end - t->start, 1);
+            else
+                r = jsmn_write_raw(w, js + t->start, t->end - t->start);
+            return r < 0 ? r : 1;
+    }
+}
+
+jsmnint_t jsmn_transcode(const char* json_text, jsmntok_t* token, jsmn_writer* w)
+{
+    return jsmn_transcode_token(json_text, token, w, 0);
+}
+
+typedef struct {
+    const char* js;
+    jsmn_writer* w;
+} jsmn_transcode_ctx;
+
+static int jsmn_transcode_event(
+    jsmn_transcode_ctx* ctx, jsmnevent_t event, jsmnint_t start, jsmnint_t end)
+{
+    jsmn_writer* w = ctx->w;
+
+    switch(event)
+    {
+        case JSMN_EVENT_OBJECT_START: return jsmn_writer_begin(w, '{');
+        case JSMN_EVENT_OBJECT_END: return jsmn_writer_end(w, '}');
+        case JSMN_EVENT_ARRAY_START: return jsmn_writer_begin(w, '[');
+        case JSMN_EVENT_ARRAY_END: return jsmn_writer_end(w, ']');
+        case JSMN_EVENT_KEY:
+            return jsmn_writer_quoted(w, ctx->js + start, end - start, 1);
+        case JSMN_EVENT_STRING:
+            return jsmn_writer_quoted(w, ctx->js + start, end - start, 0);
+        default:
+            return jsmn_write_raw(w, ctx->js + start, end - start);
+    }
+}
+
+#define JSMN_SAX_NAME jsmn_transcode_scan
+#define JSMN_SAX_EMIT(ctx, event, start, end) \
+    jsmn_transcode_event((jsmn_transcode_ctx*)(ctx), event, start, end)
+#include "jsmn_sax.h"
+
+jsmnint_t jsmn_transcode_text(const char* js, size_t len, jsmn_writer* w)
+{
+    jsmn_transcode_ctx ctx;
+    jsmnint_t r;
+
+    ctx.js = js;
+    ctx.w = w;
+    r = jsmn_transcode_scan(js, len, &ctx);
+    return r == JSMN_ERROR_STOPPED ? w->error : r;
+}
+
+int jsmn_minify_text(const char* js, size_t len, jsmn_writer* w)
+{
+    const char* end = js + len;
+    char *out, c;
+    int in_string = 0;
+#ifdef JSMN_SSE2
+    __m128i v, quote, slash, sp, tab, nl, cr;
+    int ws, q, n;
+
+    quote = _mm_set1_epi8('"');
+    slash = _mm_set1_epi8('\\');
+    sp = _mm_set1_epi8(' ');
+    tab = _mm_set1_epi8('\t');
+    nl = _mm_set1_epi8('\n');
+    cr = _mm_set1_epi8('\r');
+#endif
+
+    /* output is never longer than input */
+    if(jsmn_writer_value(w, len))
+        return w->error;
+    out = w->buf + w->len;
+
+    while(js < end)
+    {
+#ifdef JSMN_SSE2
+        n = 0;
+        while(end - js >= 16)
+        {
+            v = _mm_loadu_si128((const __m128i*)js);
+            q = _mm_movemask_epi8(_mm_cmpeq_epi8(v, quote));
+            if(in_string)
+            {
+                /* copy string blocks up to a quote or backslash */
+                q |= _mm_movemask_epi8(_mm_cmpeq_epi8(v, slash));
+                if(q)
+                    break;
+                _mm_storeu_si128((__m128i*)out, v);
+                out += 16;
+                js += 16;
+                continue;
+            }
+            ws = _mm_movemask_epi8(_mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, tab)),
+                _mm_or_si128(_mm_cmpeq_epi8(v, nl), _mm_cmpeq_epi8(v, cr))));
+            if(ws == 0xffff)
+                js += 16;
+            else if(!ws && !q)
+            {
+                _mm_storeu_si128((__m128i*)out, v);
+                out += 16;
+                js += 16;
+            }
+            else
+            {
+                /* mixed block: scalar up to and including the first quote */
+                n = 16;
+                if(q)
+                    for(n=1;!(q & 1);n++)
+                        q >>= 1;
+                break;
+            }
+        }
+        if(n)
+        {
+            for(;n;n--,js++)
+                if(*js != ' ' && *js != '\t' && *js != '\n' && *js != '\r')
+                    *out++ = *js;
+            if(js[-1] == '"')
+                in_string = 1;
+            continue;
+        }
+        if(js == end)
+            break;
+#endif
+        c = *js++;
+        if(in_string)
+        {
+            *out++ = c;
+            if(c == '\\' && js < end)
+                *out++ = *js++;
+            else if(c == '"')
+                in_string = 0;
+        }
+        else if(c != ' ' && c != '\t' && c != '\n' && c != '\r')
+        {
+            *out++ = c;
+            if(c == '"')
+                in_string = 1;
+        }
+    }
+    w->len = out - w->buf;
+    return 0;
+}
+
+/* compare a JSON Pointer segment, with ~0 and ~1 escapes, to key text */
+static int jsmn_pointer_equals(
+    const char* seg, size_t seg_len, const char* key, size_t key_len)
+{
+    size_t i, j;
+    char c;
+
+    for(i=0,j=0;i<seg_len;i++,j++)
+    {
+        c = seg[i];
+        if(c == '~' && i + 1 < seg_len)
+            c = seg[++i] == '1' ? '/' : '~';
+        if(j == key_len || key[j] != c)
+            return 0;
+    }
+    return j == key_len;
+}
+
+/* array index of a segment, -1 if invalid */
+static jsmnint_t jsmn_pointer_index(const char* seg, size_t len)
+{
+    size_t i;
+    jsmnint_t idx = 0;
+
+    if(!len || len > (sizeof(jsmnint_t) == 8 ? 18 : 9) || (seg[0] == '0' && len > 1))
+        return -1;
+    for(i=0;i<len;i++)
+    {
+        if(seg[i] < '0' || seg[i] > '9')
+            return -1;
+        idx = idx * 10 + (seg[i] - '0');
+    }
+    return idx;
+}
+
+/* resolve one segment in container t. for objects *key is the key token */
+static jsmntok_t* jsmn_pointer_step(const char* json, jsmntok_t* t,
+    const char* seg, size_t len, jsmntok_t** key)
+{
+    jsmntok_t* k;
+    jsmnint_t i;
+
+    *key = NULL;
+    if(t->type == JSMN_OBJECT)
+    {
+        for(i=0,k=t+1;i<t->size;i++,k=jsmn_obj_next(k))
+        {
+            if(jsmn_pointer_equals(seg, len, json + k->start, k->end - k->start))
+            {
+                *key = k;
+                return k + 1;
+            }
+        }
+    }
+    else if(t->type == JSMN_ARRAY && (i = jsmn_pointer_index(seg, len)) >= 0)
+        return jsmn_array_at(t, i);
+    return NULL;
+}
+
+/* walk all but the last segment. returns the parent container or NULL */
+static jsmntok_t* jsmn_pointer_parent(const char* json, jsmntok_t* token,
+    const char* pointer, const char** last, size_t* last_len)
+{
+    const char* end;
+    jsmntok_t* key;
+
+    if(*pointer != '/')
+        return NULL;
+    for(;;)
+    {
+        ++pointer;
+        if(!(end = strchr(pointer, '/')))
+            break;
+        if(!(token = jsmn_pointer_step(json, token, pointer, end - pointer, &key)))
+            return NULL;
+        pointer = end;
+    }
+    *last = pointer;
+    *last_len = strlen(pointer);
+    return token;
+}
+
+jsmntok_t* jsmn_pointer(
+    const char* json, jsmntok_t* token, const char* pointer)
+{
+    const char* last;
+    size_t len;
+    jsmntok_t* key;
+
+    if(!*pointer)
+        return token;
+    if(!(token = jsmn_pointer_parent(json, token, pointer, &last, &len)))
+        return NULL;
+    return jsmn_pointer_step(json, token, last, len, &key);
+}
+
+int jsmn_patch_init(jsmn_patch* p, const char* json, size_t len, jsmntok_t* root)
+{
+    memset(p, 0, sizeof(*p));
+    p->json = json;
+    p->len = len;
+    p->root = root;
+    return jsmn_writer_init(&p->text, NULL, 0);
+}
+
+void jsmn_patch_destroy(jsmn_patch* p)
+{
+    free(p->splices);
+    jsmn_writer_destroy(&p->text);
+}
+
+/* record a splice whose replacement starts at text offset mark */
+static int jsmn_patch_splice(jsmn_patch* p, jsmnint_t start, jsmnint_t end, size_t mark)
+{
+    jsmn_splice* s;
+    size_t cap;
+
+    if(p->text.error)
+        return p->text.error;
+    if(p->num_splices == p->cap)
+    {
+        cap = p->cap ? p->cap * 2 : 8;
+        if(!(s = realloc(p->splices, cap * sizeof(*s))))
+            return JSMN_ERROR_NOMEM;
+        p->splices = s;
+        p->cap = cap;
+    }
+    s = &p->splices[p->num_splices++];
+    memset(s, 0, sizeof(*s));
+    s->start = s->first = start;
+    s->end = s->last = end;
+    s->text = mark;
+    s->len = p->text.len - mark;
+    return 0;
+}
+
+/* record a member remove or insert at index of container */
+static int jsmn_patch_member(jsmn_patch* p, jsmntok_t* container,
+    jsmnint_t index, jsmnint_t start, jsmnint_t end, size_t mark)
+{
+    int r;
+
+    if((r = jsmn_patch_splice(p, start, end, mark)) < 0)
+        return r;
+    p->splices[p->num_splices - 1].container = container;
+    p->splices[p->num_splices - 1].index = index;
+    return 0;
+}
+
+/* byte range of a token including the quotes of strings */
+static jsmnint_t jsmn_token_first(jsmntok_t* t)
+{
+    return t->type == JSMN_STRING ? t->start - 1 : t->start;
+}
+
+static jsmnint_t jsmn_token_last(jsmntok_t* t)
+{
+    return t->type == JSMN_STRING ? t->end + 1 : t->end;
+}
+
+static int jsmn_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/* append a pointer segment as an escaped, quoted key and a colon */
+static void jsmn_patch_key(jsmn_patch* p, const char* seg, size_t len)
+{
+    char c;
+    size_t i;
+
+    jsmn_write_raw(&p->text, "\"", 1);
+    for(i=0;i<len && !p->text.error;i++)
+    {
+        c = seg[i];
+        if(c == '~' && i + 1 < len)
+            c = seg[++i] == '1' ? '/' : '~';
+        if(!jsmn_writer_reserve(&p->text, 6))
+            jsmn_writer_escape(&p->text, &c, 1, 0);
+    }
+    jsmn_write_raw(&p->text, "\":", 2);
+}
+
+/* 1 if key, just written to the patch text at mark, is already added to
+   object obj */
+static int jsmn_patch_added(const jsmn_patch* p, jsmntok_t* obj, size_t mark)
+{
+    const jsmn_splice* s;
+    size_t i, len = p->text.len - mark;
+
+    if(p->text.error)
+        return 0;
+    for(i=0;i<p->num_splices;i++)
+    {
+        s = &p->splices[i];
+        if(s->container == obj && s->first == s->last && s->len >= len &&
+           !memcmp(p->text.buf + s->text, p->text.buf + mark, len))
+            return 1;
+    }
+    return 0;
+}
+
+/* 1 if the last splice touches the bytes of an earlier one: two ranges
+   that share bytes or an insert strictly inside a range */
+static int jsmn_patch_overlaps(const jsmn_patch* p)
+{
+    const jsmn_splice *s = &p->splices[p->num_splices - 1], *o;
+    size_t i;
+
+    for(i=0;i+1<p->num_splices;i++)
+    {
+        o = &p->splices[i];
+        if(s->first == s->last ? o->first < s->first && s->first < o->last :
+           o->first == o->last ? s->first < o->first && o->first < s->last :
+           s->first < o->last && o->first < s->last)
+            return 1;
+    }
+    return 0;
+}
+
+static int jsmn_patch_record(jsmn_patch* p, jsmnpatchop_t op,
+    const char* pointer, const char* value, size_t value_len)
+{
+    jsmntok_t *parent, *t, *key, *k;
+    const char* seg;
+    size_t len, mark;
+    jsmnint_t start, i;
+
+    mark = p->text.len;
+
+    if(!*pointer)
+    {
+        if(op == JSMN_PATCH_REMOVE)
+            return JSMN_ERROR_INVAL;
+        jsmn_write_raw(&p->text, value, value_len);
+        return jsmn_patch_splice(p, jsmn_token_first(p->root),
+            jsmn_token_last(p->root), mark);
+    }
+
+    if(!(parent = jsmn_pointer_parent(p->json, p->root, pointer, &seg, &len)))
+        return JSMN_ERROR_NOFOUND;
+    if(parent->type != JSMN_OBJECT && parent->type != JSMN_ARRAY)
+        return JSMN_ERROR_NOFOUND;
+    t = jsmn_pointer_step(p->json, parent, seg, len, &key);
+
+    /* commas are placed by jsmn_patch_commas when the patch is written */
+    if(op == JSMN_PATCH_ADD && parent->type == JSMN_ARRAY)
+    {
+        i = len == 1 && *seg == '-' ? parent->size : jsmn_pointer_index(seg, len);
+        if(i < 0 || i > parent->size)
+            return JSMN_ERROR_NOFOUND;
+        /* in front of element i or before the closing bracket */
+        start = i < parent->size ? jsmn_token_first(t) : parent->end - 1;
+        jsmn_write_raw(&p->text, value, value_len);
+        return jsmn_patch_member(p, parent, i, start, start, mark);
+    }
+
+    if(op == JSMN_PATCH_ADD && !t)
+    {
+        /* new member before the closing brace, once per key */
+        jsmn_patch_key(p, seg, len);
+        if(jsmn_patch_added(p, parent, mark))
+            return JSMN_ERROR_INVAL;
+        jsmn_write_raw(&p->text, value, value_len);
+        return jsmn_patch_member(p, parent, parent->size,
+            parent->end - 1, parent->end - 1, mark);
+    }
+
+    if(!t)
+        return JSMN_ERROR_NOFOUND;
+
+    if(op != JSMN_PATCH_REMOVE)
+    {
+        jsmn_write_raw(&p->text, value, value_len);
+        return jsmn_patch_splice(p, jsmn_token_first(t), jsmn_token_last(t), mark);
+    }
+
+    if(key)
+        for(i=0,k=parent+1;k!=key;i++,k=jsmn_obj_next(k))
+            ;
+    else
+        i = jsmn_pointer_index(seg, len);
+    return jsmn_patch_member(p, parent, i,
+        jsmn_token_first(key ? key : t), jsmn_token_last(t), mark);
+}
+
+int jsmn_patch_op(jsmn_patch* p, jsmnpatchop_t op, const char* pointer,
+    const char* value, size_t value_len)
+{
+    size_t n = p->num_splices, mark = p->text.len;
+    int r;
+
+    r = jsmn_patch_record(p, op, pointer, value, value_len);
+    if(!r && jsmn_patch_overlaps(p))
+        r = JSMN_ERROR_INVAL;
+    /* a rejected operation leaves the patch as it was */
+    if(r < 0)
+    {
+        p->num_splices = n;
+        p->text.len = mark;
+    }
+    return r;
+}
+
+/* order by container, index, inserts before the remove at their index */
+static int jsmn_splice_member_cmp(const void* a, const void* b)
+{
+    const jsmn_splice *x = (const jsmn_splice*)a, *y = (const jsmn_splice*)b;
+    if(x->container != y->container)
+        return x->container < y->container ? -1 : 1;
+    if(x->index != y->index)
+        return x->index < y->index ? -1 : 1;
+    if((x->first == x->last) != (y->first == y->last))
+        return x->first == x->last ? -1 : 1;
+    return x->text < y->text ? -1 : x->text > y->text;
+}
+
+static int jsmn_splice_cmp(const void* a, const void* b)
+{
+    const jsmn_splice *x = (const jsmn_splice*)a, *y = (const jsmn_splice*)b;
+    if(x->start != y->start)
+        return x->start < y->start ? -1 : 1;
+    /* inserts go in front of a removal at the same position and keep the
+       order they were added in */
+    if((x->start == x->end) != (y->start == y->end))
+        return x->start == x->end ? -1 : 1;
+    return x->text < y->text ? -1 : x->text > y->text;
+}
+
+/* the whitespace and comma between two members, starting after the
+   first or ending before the second */
+static jsmnint_t jsmn_patch_gap_end(const char* json, jsmnint_t i)
+{
+    while(jsmn_is_space(json[i]))
+        i++;
+    for(i++;jsmn_is_space(json[i]);i++)
+        ;
+    return i;
+}
+
+static jsmnint_t jsmn_patch_gap_start(const char* json, jsmnint_t i)
+{
+    while(jsmn_is_space(json[i - 1]))
+        i--;
+    for(i--;jsmn_is_space(json[i - 1]);i--)
+        ;
+    return i;
+}
+
+/* place the commas of one container whose removes and inserts are
+   s[0..n), sorted by jsmn_splice_member_cmp. walks the members in order
+   and keeps an original comma only if an item was written since the
+   last one and another follows. a dropped comma goes with a removed
+   neighbour, inserts get their own. runs of untouched members are
+   skipped, so the cost depends on the number of edits */
+static void jsmn_patch_commas(const char* json, jsmn_splice* s, size_t n)
+{
+    jsmn_splice *rem, *ins = NULL;
+    jsmnint_t size = s[0].container->size;
+    jsmnint_t i, next, last = -1;
+    size_t k;
+    int have = 0, comma = 0;
+
+    /* sequence position of the last item written: insert before member
+       i at 2 i, member i at 2 i + 1 */
+    for(k=n,i=size-1;k>0;k--)
+    {
+        if(s[k - 1].first != s[k - 1].last && s[k - 1].index == i)
+            i--;
+        else if(s[k - 1].index > i)
+            continue;
+        else
+            break;
+    }
+    last = 2 * i + 1;
+    for(k=0;k<n;k++)
+        if(s[k].first == s[k].last && 2 * s[k].index > last)
+            last = 2 * s[k].index;
+
+    for(i=0,k=0;;i++)
+    {
+        for(;k < n && s[k].index == i && s[k].first == s[k].last;k++)
+        {
+            if(have && !comma)
+                s[k].comma |= 1;
+            ins = &s[k];
+            have = 1;
+            comma = 0;
+        }
+        if(i == size)
+            break;
+
+        rem = k < n && s[k].index == i ? &s[k++] : NULL;
+        if(!rem)
+        {
+            /* only an insert can come right before a member */
+            if(have && !comma)
+                ins->comma |= 2;
+            have = 1;
+            comma = 0;
+            next = k < n ? s[k].index : size;
+            if(next > i + 1)
+                i = next - 1;
+        }
+
+        if(i < size - 1)
+        {
+            if(have && !comma && last > 2 * i + 1)
+                comma = 1;
+            else if(rem)
+                rem->end = jsmn_patch_gap_end(json, rem->end);
+            else if(k < n)
+                s[k].start = jsmn_patch_gap_start(json, s[k].start);
+        }
+    }
+}
+
+/* place commas, sort splices by position and check they do not overlap */
+static int jsmn_patch_sort(jsmn_patch* p)
+{
+    size_t i, j;
+
+    for(i=0;i<p->num_splices;i++)
+    {
+        p->splices[i].start = p->splices[i].first;
+        p->splices[i].end = p->splices[i].last;
+        p->splices[i].comma = 0;
+    }
+    qsort(p->splices, p->num_splices, sizeof(jsmn_splice), jsmn_splice_member_cmp);
+    for(i=0;i<p->num_splices;i=j)
+    {
+        for(j=i+1;j<p->num_splices &&
+            p->splices[j].container == p->splices[i].container;j++)
+            ;
+        if(p->splices[i].container)
+            jsmn_patch_commas(p->json, p->splices + i, j - i);
+    }
+
+    qsort(p->splices, p->num_splices, sizeof(jsmn_splice), jsmn_splice_cmp);
+    for(i=1;i<p->num_splices;i++)
+        if(p->splices[i].start < p->splices[i - 1].end)
+            return JSMN_ERROR_INVAL;
+    return 0;
+}
+
+static size_t jsmn_patch_length(jsmn_patch* p)
+{
+    jsmn_splice* s;
+    size_t i, n = p->len;
+
+    for(i=0;i<p->num_splices;i++)
+    {
+        s = &p->splices[i];
+        n += s->len + (s->comma & 1) + (s->comma >> 1) - (s->end - s->start);
+    }
+    return n;
+}
+
+size_t jsmn_patch_size(jsmn_patch* p)
+{
+    jsmn_patch_sort(p);
+    return jsmn_patch_length(p);
+}
+
+int jsmn_patch_write(jsmn_patch* p, jsmn_writer* w)
+{
+    jsmn_splice* s;
+    size_t i, pos = 0;
+    int r;
+
+    if((r = jsmn_patch_sort(p)) < 0)
+        return r;
+    if(jsmn_writer_value(w, jsmn_patch_length(p)))
+        return w->error;
+    for(i=0;i<p->num_splices;i++)
+    {
+        s = &p->splices[i];
+        memcpy(w->buf + w->len, p->json + pos, s->start - pos);
+        w->len += s->start - pos;
+        if(s->comma & 1)
+            w->buf[w->len++] = ',';
+        memcpy(w->buf + w->len, p->text.buf + s->text, s->len);
+        w->len += s->len;
+        if(s->comma & 2)
+            w->buf[w->len++] = ',';
+        pos = s->end;
+    }
+    memcpy(w->buf + w->len, p->json + pos, p->len - pos);
+    w->len += p->len - pos;
+    return 0;
+}
+
+int jsmn_patch_iovec(jsmn_patch* p, jsmn_iovec* iov, int max_iov)
+{
+    static const char comma[] = ",";
+    jsmn_splice* s;
+    size_t i, pos = 0;
+    int n = 0, r;
+
+    if((r = jsmn_patch_sort(p)) < 0)
+        return r;
+    for(i=0;i<=p->num_splices;i++)
+    {
+        s = i < p->num_splices ? &p->splices[i] : NULL;
+        if((s ? (size_t)s->start : p->len) > pos)
+        {
+            if(n == max_iov)
+                return JSMN_ERROR_NOMEM;
+            iov[n].iov_base = (void*)(p->json + pos);
+            iov[n++].iov_len = (s ? (size_t)s->start : p->len) - pos;
+        }
+        if(s && (s->comma & 1))
+        {
+            if(n == max_iov)
+                return JSMN_ERROR_NOMEM;
+            iov[n].iov_base = (void*)comma;
+            iov[n++].iov_len = 1;
+        }
+        if(s && s->len)
+        {
+            if(n == max_iov)
+                return JSMN_ERROR_NOMEM;
+            iov[n].iov_base = p->text.buf + s->text;
+            iov[n++].iov_len = s->len;
+        }
+        if(s && (s->comma & 2))
+        {
+            if(n == max_iov)
+                return JSMN_ERROR_NOMEM;
+            iov[n].iov_base = (void*)comma;
+            iov[n++].iov_len = 1;
+        }
+        if(s)
+            pos = s->end;
+    }
+    return n;
+}
+
+#ifdef JSMN_PARENT_LINKS
+static void jsmn_fp_refold(jsmn_parser *parser, const char *js, jsmnint_t i);
+
+jsmnint_t jsmn_reparse(jsmn_parser *parser, const char *js, size_t len,
+        size_t offset, size_t removed, size_t inserted)
+{
+    jsmn_parser sub;
+    jsmntok_t *t, *tok;
+    jsmnint_t count = parser->toknext;
+    jsmnint_t delta = (jsmnint_t)inserted - (jsmnint_t)removed;
+    jsmnint_t ci = -1, k, m, i, r, base;
+    jsmnuint_t sz;
+
+    /* smallest container whose brackets enclose the edit */
+    for(i=0;i<count;i++)
+    {
+        t = &parser->tokens[i];
+        if((t->type == JSMN_OBJECT || t->type == JSMN_ARRAY) &&
+           (size_t)t->start < offset && offset + removed < (size_t)t->end)
+            ci = i;
+        else if((size_t)t->start > offset)
+            break;
+    }
+
+    if(ci >= 0)
+    {
+        t = &parser->tokens[ci];
+        jsmn_init(&sub);
+        sub.intern = parser->intern;
+        sub.fingerprint = parser->fingerprint;
+        r = jsmn_parse_dynamic(&sub, js + t->start, t->end + delta - t->start);
+        /* the edit must leave one value closing where the container did */
+        if(r > 0 && sub.tokens[0].end != t->end + delta - t->start)
+            r = JSMN_ERROR_INVAL;
+        if(r < 0)
+        {
+            jsmn_destroy(&sub);
+            return r;
+        }
+        m = r;
+
+        for(k=1;ci + k < count && parser->tokens[ci + k].start < t->end;k++)
+            ;
+        if(count - k + m > (jsmnint_t)parser->num_tokens)
+        {
+            sz = count - k + m;
+            if(!parser->owns_tokens ||
+               !(tok = realloc(parser->tokens, sz * sizeof(jsmntok_t))))
+            {
+                jsmn_destroy(&sub);
+                return JSMN_ERROR_NOMEM;
+            }
+            parser->tokens = tok;
+            parser->num_tokens = sz;
+            t = &parser->tokens[ci];
+        }
+        if((parser->intern && jsmn_key_ids_reserve(parser, count - k + m)) ||
+           (parser->fingerprint && jsmn_hashes_reserve(parser, count - k + m)))
+        {
+            jsmn_destroy(&sub);
+            return JSMN_ERROR_NOMEM;
+        }
+
+        /* enclosing containers end later, tokens behind the container move */
+        for(i=t->parent;i!=-1;i=parser->tokens[i].parent)
+            if(parser->tokens[i].type == JSMN_OBJECT ||
+               parser->tokens[i].type == JSMN_ARRAY)
+                parser->tokens[i].end += delta;
+        base = t->start;
+        sub.tokens[0].parent = t->parent - ci;
+        memmove(parser->tokens + ci + m, parser->tokens + ci + k,
+                (count - ci - k) * sizeof(jsmntok_t));
+        if(parser->intern)
+        {
+            memmove(parser->key_ids + ci + m, parser->key_ids + ci + k,
+                    (count - ci - k) * sizeof(int32_t));
+            memcpy(parser->key_ids + ci, sub.key_ids, m * sizeof(int32_t));
+        }
+        if(parser->fingerprint)
+        {
+            memmove(parser->hashes + ci + m, parser->hashes + ci + k,
+                    (count - ci - k) * sizeof(uint64_t));
+            memcpy(parser->hashes + ci, sub.hashes, m * sizeof(uint64_t));
+        }
+        for(i=ci+m;i<count-k+m;i++)
+        {
+            tok = &parser->tokens[i];
+            tok->start += delta;
+            tok->end += delta;
+            if(tok->parent >= ci + k)
+                tok->parent += m - k;
+        }
+        for(i=0;i<m;i++)
+        {
+            tok = &parser->tokens[ci + i];
+            *tok = sub.tokens[i];
+            tok->start += base;
+            tok->end += base;
+            tok->parent += ci;
+        }
+        jsmn_destroy(&sub);
+
+        parser->toknext = count - k + m;
+        if(parser->fingerprint)
+            jsmn_fp_refold(parser, js, ci);
+        parser->pos += delta;
+        return parser->toknext;
+    }
+
+    /* nothing encloses the edit */
+    parser->pos = 0;
+    parser->toknext = 0;
+    parser->toksuper = -1;
+    if(parser->owns_tokens)
+        return jsmn_parse(parser, js, len, NULL, 0);
+    return jsmn_parse(parser, js, len, parser->tokens, parser->num_tokens);
+}
+#endif
+
+#define JSMN_HASH_P1 0x9E3779B97F4A7C15ULL
+#define JSMN_HASH_P2 0xC2B2AE3D27D4EB4FULL
+
+static uint64_t jsmn_rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t jsmn_hash_round(uint64_t acc, uint64_t w)
+{
+    return jsmn_rotl64(acc + w * JSMN_HASH_P2, 31) * JSMN_HASH_P1;
+}
+
+static uint64_t jsmn_hash_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t jsmn_hash(const void* data, size_t len, uint64_t seed)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    const unsigned char* end = p + len;
+    uint64_t v[4], w, h;
+    int i;
+
+    h = seed + JSMN_HASH_P1 * (uint64_t)len;
+    if(len >= 32)
+    {
+        /* four independent lanes keep the multipliers busy */
+        v[0] = seed + JSMN_HASH_P1;
+        v[1] = seed + JSMN_HASH_P2;
+        v[2] = seed;
+        v[3] = seed - JSMN_HASH_P1;
+        for(;end - p >= 32;p+=32)
+        {
+            for(i=0;i<4;i++)
+            {
+                memcpy(&w, p + i * 8, 8);
+                v[i] = jsmn_hash_round(v[i], w);
+            }
+        }
+        h ^= jsmn_rotl64(v[0], 1) + jsmn_rotl64(v[1], 7) +
+            jsmn_rotl64(v[2], 12) + jsmn_rotl64(v[3], 18);
+    }
+    for(;end - p >= 8;p+=8)
+    {
+        memcpy(&w, p, 8);
+        h = jsmn_rotl64(h ^ jsmn_hash_round(0, w), 27) * JSMN_HASH_P1;
+    }
+    for(;p<end;p++)
+        h = jsmn_rotl64(h ^ (*p * JSMN_HASH_P2), 11) * JSMN_HASH_P1;
+    return jsmn_hash_mix(h);
+}
+
+#ifdef JSMN_PARENT_LINKS
+/* fold the finished hash of token c into its parent. a key folds its value
+   in order and is then itself finished */
+static void jsmn_fp_fold(jsmn_parser *parser, jsmnint_t c)
+{
+    jsmntok_t *t;
+    jsmnint_t p;
+
+    for(p=parser->tokens[c].parent;p!=-1;c=p,p=t->parent)
+    {
+        t = &parser->tokens[p];
+        if(t->type == JSMN_OBJECT &&
+           parser->fingerprint == JSMN_FINGERPRINT_UNORDERED)
+        {
+            parser->hashes[p] += jsmn_hash_mix(parser->hashes[c]);
+            return;
+        }
+        parser->hashes[p] = jsmn_hash_round(parser->hashes[p], parser->hashes[c]);
+        if(t->type == JSMN_OBJECT || t->type == JSMN_ARRAY)
+            return;
+    }
+}
+
+static void jsmn_fp_leaf(jsmn_parser *parser, const char *js, jsmnint_t i)
+{
+    jsmntok_t *t = &parser->tokens[i];
+
+    parser->hashes[i] = jsmn_hash(js + t->start, t->end - t->start, t->type);
+    /* a key waits for its value */
+    if(t->parent == -1 || parser->tokens[t->parent].type != JSMN_OBJECT)
+        jsmn_fp_fold(parser, i);
+}
+
+static void jsmn_fp_close(jsmn_parser *parser, jsmnint_t i)
+{
+    jsmntok_t *t = &parser->tokens[i];
+
+    parser->hashes[i] = jsmn_hash_mix(parser->hashes[i] +
+        (uint64_t)t->type * JSMN_HASH_P2 + (uint64_t)t->size);
+    jsmn_fp_fold(parser, i);
+}
+
+/* token i was replaced by jsmn_reparse. recompute the keys and containers
+   that enclose it from the hashes of their children */
+static void jsmn_fp_refold(jsmn_parser *parser, const char *js, jsmnint_t i)
+{
+    jsmntok_t *t;
+    jsmnint_t p, j;
+
+    for(p=parser->tokens[i].parent;p!=-1;i=p,p=t->parent)
+    {
+        t = &parser->tokens[p];
+        if(t->type != JSMN_OBJECT && t->type != JSMN_ARRAY)
+        {
+            parser->hashes[p] = jsmn_hash_round(
+                jsmn_hash(js + t->start, t->end - t->start, t->type),
+                parser->hashes[i]);
+            continue;
+        }
+        parser->hashes[p] = 0;
+        for(j=p+1;j<(jsmnint_t)parser->toknext && parser->tokens[j].start < t->end;j++)
+        {
+            if(parser->tokens[j].parent != p)
+                continue;
+            if(t->type == JSMN_OBJECT &&
+               parser->fingerprint == JSMN_FINGERPRINT_UNORDERED)
+                parser->hashes[p] += jsmn_hash_mix(parser->hashes[j]);
+            else
+                parser->hashes[p] = jsmn_hash_round(parser->hashes[p],
+                    parser->hashes[j]);
+        }
+        parser->hashes[p] = jsmn_hash_mix(parser->hashes[p] +
+            (uint64_t)t->type * JSMN_HASH_P2 + (uint64_t)t->size);
+    }
+}
+#endif
+
+/* map a whole file. text maps it read only and hints the kernel to read
+   ahead aggressively, else the mapping is private copy on write. falls
+   back to reading it into memory where mmap is not available. returns
+   NULL on failure or for an empty file */
+static void* jsmn_map_file(const char* path, size_t* len, int text)
+{
+#if defined(JSMN_MMAP_POSIX)
+    struct stat st;
+    void* map;
+    int fd;
+
+    if((fd = open(path, O_RDONLY)) < 0)
+        return NULL;
+    if(fstat(fd, &st) || !st.st_size || (uint64_t)st.st_size > (size_t)-1)
+    {
+        close(fd);
+        return NULL;
+    }
+    *len = (size_t)st.st_size;
+    map = mmap(NULL, *len, text ? PROT_READ : PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED)
+        return NULL;
+    if(text)
+    {
+#ifdef MADV_SEQUENTIAL
+        madvise(map, *len, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_HUGEPAGE
+        madvise(map, *len, MADV_HUGEPAGE);
+#endif
+    }
+    return map;
+#elif defined(JSMN_MMAP_WIN32)
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+    void* map = NULL;
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, text ? FILE_FLAG_SEQUENTIAL_SCAN : 0, NULL);
+    if(file == INVALID_HANDLE_VALUE)
+        return NULL;
+    if(GetFileSizeEx(file, &size) && size.QuadPart &&
+       (uint64_t)size.QuadPart <= (size_t)-1)
+    {
+        *len = (size_t)size.QuadPart;
+        if((mapping = CreateFileMappingA(file, NULL,
+                text ? PAGE_READONLY : PAGE_WRITECOPY, 0, 0, NULL)))
+        {
+            map = MapViewOfFile(mapping, text ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    return map;
+#else
+    FILE* f;
+    char* buf;
+    long n = 0;
+
+    (void)text;
+    if(!(f = fopen(path, "rb")))
+        return NULL;
+    buf = NULL;
+    if(!fseek(f, 0, SEEK_END) && (n = ftell(f)) > 0 && !fseek(f, 0, SEEK_SET) &&
+       (buf = malloc(n)) && fread(buf, 1, n, f) != (size_t)n)
+    {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *len = (size_t)n;
+    return buf;
+#endif
+}
+
+static void jsmn_unmap_file(void* map, size_t len)
+{
+    if(!map)
+        return;
+#if defined(JSMN_MMAP_POSIX)
+    munmap(map, len);
+#elif defined(JSMN_MMAP_WIN32)
+    (void)len;
+    UnmapViewOfFile(map);
+#else
+    (void)len;
+    free(map);
+#endif
+}
+
+#define JSMN_CACHE_VERSION 2
+#define JSMN_CACHE_STRICT 1
+#define JSMN_CACHE_PARENT_LINKS 2
+#define JSMN_CACHE_LARGE 4
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t token_size;
+    uint32_t reserved;
+    uint64_t num_tokens;
+    uint64_t text_len;
+    uint64_t text_hash;
+    uint64_t token_hash;
+} jsmn_cache_header;
+
+static void jsmn_cache_header_init(jsmn_cache_header* h,
+    const char* js, size_t len, const jsmntok_t* tokens, jsmnuint_t num_tokens)
+{
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, "JSMNTOK\n", 8);
+    h->version = JSMN_CACHE_VERSION;
+#ifdef JSMN_STRICT
+    h->flags |= JSMN_CACHE_STRICT;
+#endif
+#ifdef JSMN_PARENT_LINKS
+    h->flags |= JSMN_CACHE_PARENT_LINKS;
+#endif
+#ifdef JSMN_LARGE
+    h->flags |= JSMN_CACHE_LARGE;
+#endif
+    h->token_size = sizeof(jsmntok_t);
+    h->num_tokens = num_tokens;
+    h->text_len = len;
+    h->text_hash = jsmn_hash(js, len, 0);
+    h->token_hash = jsmn_hash(tokens, num_tokens * sizeof(jsmntok_t), 0);
+}
+
+int jsmn_cache_save(const char* path, const char* js, size_t len,
+    const jsmntok_t* tokens, jsmnuint_t num_tokens)
+{
+    jsmn_cache_header h;
+    FILE* f;
+    int ok;
+
+    jsmn_cache_header_init(&h, js, len, tokens, num_tokens);
+    if(!(f = fopen(path, "wb")))
+        return JSMN_ERROR_IO;
+    ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+        fwrite(tokens, sizeof(jsmntok_t), num_tokens, f) == num_tokens;
+    if(fclose(f) || !ok)
+    {
+        remove(path);
+        return JSMN_ERROR_IO;
+    }
+    return 0;
+}
+
+/* check that tokens read from a file describe a document of len bytes:
+   valid types and ranges, and sizes (and parent links) that form a tree
+   in document order, objects holding keys with one value each. the
+   navigation helpers trust all of these. returns 0 or JSMN_ERROR_INVAL */
+static int jsmn_cache_check(const jsmntok_t* t, jsmnuint_t n, size_t len)
+{
+    jsmnint_t *stack = NULL, *b; /* open container and children left */
+    size_t depth = 0, cap = 0;
+    const jsmntok_t* up;
+    jsmnuint_t i;
+    int r = JSMN_ERROR_INVAL;
+
+    for(i=0;i<n;i++)
+    {
+        if(t[i].type < JSMN_OBJECT || t[i].type > JSMN_PRIMITIVE ||
+           t[i].start < 0 || t[i].start > t[i].end || (size_t)t[i].end > len ||
+           (t[i].type == JSMN_STRING && (!t[i].start || (size_t)t[i].end == len)) ||
+           t[i].size < 0 || (jsmnuint_t)t[i].size >= n - i)
+            goto done;
+        up = depth ? &t[stack[depth * 2 - 2]] : NULL;
+#ifdef JSMN_PARENT_LINKS
+        if(t[i].parent != (depth ? stack[depth * 2 - 2] : -1))
+            goto done;
+#endif
+        if(t[i].type == JSMN_STRING || t[i].type == JSMN_PRIMITIVE)
+        {
+            /* a key has its value as only child */
+            if(t[i].size != (up && up->type == JSMN_OBJECT))
+                goto done;
+        }
+        else if(up && up->type == JSMN_OBJECT)
+            goto done;
+
+        if(depth && !--stack[depth * 2 - 1])
+            depth--;
+        if(t[i].size)
+        {
+            if(depth == cap)
+            {
+                cap = cap ? cap * 2 : 32;
+                if(!(b = realloc(stack, cap * 2 * sizeof(*stack))))
+                {
+                    r = JSMN_ERROR_NOMEM;
+                    goto done;
+                }
+                stack = b;
+            }
+            stack[depth * 2] = (jsmnint_t)i;
+            stack[depth * 2 + 1] = t[i].size;
+            depth++;
+        }
+    }
+    r = depth ? JSMN_ERROR_INVAL : 0;
+done:
+    free(stack);
+    return r;
+}
+
+int jsmn_cache_load(jsmn_cache* cache, const char* path,
+    const char* js, size_t len)
+{
+    jsmn_cache_header expect, *h;
+
+    memset(cache, 0, sizeof(*cache));
+    if(!(cache->map = jsmn_map_file(path, &cache->map_len, 0)))
+        return JSMN_ERROR_IO;
+
+    h = (jsmn_cache_header*)cache->map;
+    jsmn_cache_header_init(&expect, js, 0, NULL, 0);
+    if(cache->map_len < sizeof(*h) || memcmp(h->magic, "JSMNTOK\n", 8) ||
+       h->version != JSMN_CACHE_VERSION || h->flags != expect.flags ||
+       h->reserved ||
+       h->token_size != expect.token_size || h->text_len != len ||
+       h->num_tokens != (cache->map_len - sizeof(*h)) / sizeof(jsmntok_t) ||
+       (cache->map_len - sizeof(*h)) % sizeof(jsmntok_t))
+        goto stale;
+
+    /* compare hash last, it is the only check that reads the text */
+    if(h->text_hash != jsmn_hash(js, len, 0))
+        goto stale;
+
+    /* the checksum catches a damaged file, the tree check a crafted one */
+    if(h->token_hash != jsmn_hash(h + 1, h->num_tokens * sizeof(jsmntok_t), 0) ||
+       jsmn_cache_check((jsmntok_t*)(h + 1), h->num_tokens, len))
+        goto stale;
+
+    cache->tokens = (jsmntok_t*)(h + 1);
+    cache->num_tokens = h->num_tokens;
+    return 0;
+
+stale:
+    jsmn_cache_close(cache);
+    return JSMN_ERROR_INVAL;
+}
+
+void jsmn_cache_close(jsmn_cache* cache)
+{
+    jsmn_unmap_file(cache->map, cache->map_len);
+    cache->map = NULL;
+    cache->tokens = NULL;
+    cache->num_tokens = 0;
+}
+
+jsmnint_t jsmn_parse_file(jsmn_parser *parser, const char *path)
+{
+    /* a parser used for an earlier file starts over, keeping its tokens */
+    jsmn_reset(parser);
+    if(!(parser->map = (char*)jsmn_map_file(path, &parser->map_len, 1)))
+        return JSMN_ERROR_IO;
+    /* parsing is bounded by the length, the mapping needs no terminator */
+    return jsmn_parse_dynamic(parser, parser->map, parser->map_len);
+}
+
+static int jsmn_seek_index_add(jsmn_seek_index* idx, uint64_t offset)
+{
+    jsmn_checkpoint* p;
+    size_t cap;
+
+    if(idx->num_points == idx->cap)
+    {
+        cap = idx->cap ? idx->cap * 2 : 64;
+        if(!(p = realloc(idx->points, cap * sizeof(*p))))
+            return JSMN_ERROR_NOMEM;
+        idx->points = p;
+        idx->cap = cap;
+    }
+    p = &idx->points[idx->num_points++];
+    p->offset = offset;
+    p->ordinal = idx->count;
+    return 0;
+}
+
+/* streaming form of the text checksum, so the index can be built from a
+   reader and checked against a whole buffer */
+typedef struct {
+    uint64_t h;
+    uint64_t total;
+    unsigned char tail[8];
+    size_t n;
+} jsmn_text_hash;
+
+static void jsmn_text_hash_update(jsmn_text_hash* s, const char* p, size_t len)
+{
+    uint64_t w;
+
+    s->total += len;
+    for(;len && s->n;len--)
+    {
+        s->tail[s->n++] = (unsigned char)*p++;
+        if(s->n == 8)
+        {
+            memcpy(&w, s->tail, 8);
+            s->h = jsmn_rotl64(s->h ^ jsmn_hash_round(0, w), 27) *
+                JSMN_HASH_P1;
+            s->n = 0;
+        }
+    }
+    for(;len>=8;p+=8,len-=8)
+    {
+        memcpy(&w, p, 8);
+        s->h = jsmn_rotl64(s->h ^ jsmn_hash_round(0, w), 27) * JSMN_HASH_P1;
+    }
+    memcpy(s->tail + s->n, p, len);
+    s->n += len;
+}
+
+static uint64_t jsmn_text_hash_final(const jsmn_text_hash* s)
+{
+    uint64_t h = s->h ^ JSMN_HASH_P2 * s->total;
+    size_t i;
+
+    for(i=0;i<s->n;i++)
+        h = jsmn_rotl64(h ^ (s->tail[i] * JSMN_HASH_P2), 11) * JSMN_HASH_P1;
+    return jsmn_hash_mix(h);
+}
+
+static uint64_t jsmn_seek_text_hash(const char* js, size_t len)
+{
+    jsmn_text_hash s;
+
+    memset(&s, 0, sizeof(s));
+    jsmn_text_hash_update(&s, js, len);
+    return jsmn_text_hash_final(&s);
+}
+
+typedef struct {
+    jsmn_read_cb read;
+    void* user;
+    jsmn_text_hash hash;
+} jsmn_seek_source;
+
+/* read callback that checksums the input on its way into the window */
+static int jsmn_seek_read(void* user, char* buf, size_t size)
+{
+    jsmn_seek_source* s = (jsmn_seek_source*)user;
+    int got = s->read(s->user, buf, size);
+
+    if(got > 0)
+        jsmn_text_hash_update(&s->hash, buf, (size_t)got);
+    return got;
+}
+
+static int jsmn_seek_index_scan(jsmn_seek_index* idx, jsmn_reader* r)
+{
+    jsmn_event ev;
+    uint64_t offset, last = 0;
+    int c, rc;
+
+    if((rc = jsmn_next(r, &ev)) <= 0)
+        return rc < 0 ? rc : JSMN_ERROR_PART;
+    if(ev.type != JSMN_EVENT_ARRAY_START)
+        return JSMN_ERROR_WRONG_TYPE;
+    idx->array_start = ev.start;
+
+    for(;;)
+    {
+        if((c = jsmn_reader_peek(r)) <= 0)
+            return c < 0 ? c : JSMN_ERROR_PART;
+        if(c == ']')
+            break;
+        offset = r->base + r->pos;
+        if(!idx->count || offset - last >= idx->interval)
+        {
+            if((rc = jsmn_seek_index_add(idx, offset)) < 0)
+                return rc;
+            last = offset;
+        }
+        if((rc = jsmn_skip_value(r)) <= 0)
+            return rc < 0 ? rc : JSMN_ERROR_INVAL;
+        idx->count++;
+    }
+    if((rc = jsmn_next(r, &ev)) < 0)
+        return rc;
+    /* the index is only valid for exactly this input */
+    if((c = jsmn_reader_peek(r)) != 0)
+        return c < 0 ? c : JSMN_ERROR_INVAL;
+    idx->text_len = r->base + r->len;
+    return 0;
+}
+
+int jsmn_seek_index_build(jsmn_seek_index* idx, jsmn_reader* r,
+    uint64_t interval)
+{
+    jsmn_seek_source src;
+    int rc;
+
+    memset(idx, 0, sizeof(*idx));
+    idx->interval = interval;
+    /* a fresh reader holds the input read so far, a buffer reader all of
+       it. the rest is checksummed as it is read */
+    memset(&src, 0, sizeof(src));
+    jsmn_text_hash_update(&src.hash, r->buf, r->len);
+    src.read = r->read;
+    src.user = r->user;
+    if(r->read)
+    {
+        r->read = jsmn_seek_read;
+        r->user = &src;
+    }
+    rc = jsmn_seek_index_scan(idx, r);
+    r->read = src.read;
+    r->user = src.user;
+    if(rc < 0)
+    {
+        jsmn_seek_index_destroy(idx);
+        return rc;
+    }
+    idx->text_hash = jsmn_text_hash_final(&src.hash);
+    return 0;
+}
+
+void jsmn_seek_index_destroy(jsmn_seek_index* idx)
+{
+    free(idx->points);
+    idx->points = NULL;
+    idx->num_points = idx->cap = 0;
+}
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t interval;
+    uint64_t count;
+    uint64_t array_start;
+    uint64_t text_len;
+    uint64_t num_points;
+    uint64_t text_hash;
+} jsmn_seek_header;
+
+int jsmn_seek_index_save(const jsmn_seek_index* idx, const char* path)
+{
+    jsmn_seek_header h;
+    FILE* f;
+    int ok;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "JSMNIDX\n", 8);
+    h.version = 2;
+    h.interval = idx->interval;
+    h.count = idx->count;
+    h.array_start = idx->array_start;
+    h.text_len = idx->text_len;
+    h.num_points = idx->num_points;
+    h.text_hash = idx->text_hash;
+
+    if(!(f = fopen(path, "wb")))
+        return JSMN_ERROR_IO;
+    ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+        fwrite(idx->points, sizeof(jsmn_checkpoint), idx->num_points, f) ==
+            idx->num_points;
+    if(fclose(f) || !ok)
+    {
+        remove(path);
+        return JSMN_ERROR_IO;
+    }
+    return 0;
+}
+
+/* checkpoints must be elements of the array, in order, starting with the
+   first. 1 if they are */
+static int jsmn_seek_index_check(const jsmn_seek_index* idx)
+{
+    const jsmn_checkpoint* p = idx->points;
+    size_t i;
+
+    if(idx->array_start >= idx->text_len)
+        return 0;
+    if(idx->num_points && p[0].ordinal != 0)
+        return 0;
+    for(i=0;i<idx->num_points;i++)
+    {
+        if(p[i].offset <= idx->array_start || p[i].offset >= idx->text_len ||
+                p[i].ordinal >= idx->count)
+            return 0;
+        if(i && (p[i].offset <= p[i - 1].offset ||
+                 p[i].ordinal <= p[i - 1].ordinal))
+            return 0;
+    }
+    return 1;
+}
+
+int jsmn_seek_index_load(jsmn_seek_index* idx, const char* path,
+    const char* js, size_t len)
+{
+    jsmn_seek_header h;
+    FILE* f;
+    int rc = 0;
+
+    memset(idx, 0, sizeof(*idx));
+    if(!(f = fopen(path, "rb")))
+        return JSMN_ERROR_IO;
+    if(fread(&h, sizeof(h), 1, f) != 1)
+        rc = JSMN_ERROR_IO;
+    else if(memcmp(h.magic, "JSMNIDX\n", 8) || h.version != 2 ||
+            !h.num_points != !h.count || h.num_points > h.count ||
+            h.num_points > (size_t)-1 / sizeof(jsmn_checkpoint) ||
+            h.text_len != len || (js && h.text_hash !=
+                jsmn_seek_text_hash(js, len)))
+        rc = JSMN_ERROR_INVAL;
+    else if(h.num_points &&
+            !(idx->points = malloc(h.num_points * sizeof(jsmn_checkpoint))))
+        rc = JSMN_ERROR_NOMEM;
+    else if(fread(idx->points, sizeof(jsmn_checkpoint), h.num_points, f) !=
+            h.num_points)
+        rc = JSMN_ERROR_IO;
+    fclose(f);
+
+    if(rc == 0)
+    {
+        idx->num_points = idx->cap = h.num_points;
+        idx->interval = h.interval;
+        idx->count = h.count;
+        idx->array_start = h.array_start;
+        idx->text_len = h.text_len;
+        idx->text_hash = h.text_hash;
+        if(!jsmn_seek_index_check(idx))
+            rc = JSMN_ERROR_INVAL;
+    }
+    if(rc < 0)
+    {
+        jsmn_seek_index_destroy(idx);
+        return rc;
+    }
+    return 0;
+}
+
+int jsmn_seek_index_find(const jsmn_seek_index* idx, uint64_t i,
+    jsmn_checkpoint* cp)
+{
+    size_t lo = 0, hi = idx->num_points, mid;
+
+    if(i >= idx->count || !hi)
+        return JSMN_ERROR_NOFOUND;
+    /* last checkpoint with ordinal <= i. the first one is element 0 */
+    while(hi - lo > 1)
+    {
+        mid = lo + (hi - lo) / 2;
+        if(idx->points[mid].ordinal <= i)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    *cp = idx->points[lo];
+    return 0;
+}
+
+void jsmn_reader_resume(jsmn_reader* r, const jsmn_seek_index* idx,
+    const jsmn_checkpoint* cp)
+{
+    r->base = cp->offset;
+    r->depth = 1;
+    r->expect_key = 0;
+    r->is_object[0] = 0;
+    r->open[0] = idx->array_start;
+}
+
+int jsmn_seek_element(const jsmn_seek_index* idx, const char* js,
+    size_t len, uint64_t i, size_t* start, size_t* end)
+{
+    jsmn_checkpoint cp;
+    jsmn_reader r;
+    uint64_t n;
+    int c, rc;
+
+    if(len != idx->text_len)
+        return JSMN_ERROR_INVAL;
+    if((rc = jsmn_seek_index_find(idx, i, &cp)) < 0)
+        return rc;
+
+    jsmn_reader_init_buffer(&r, js + cp.offset, len - cp.offset);
+    jsmn_reader_resume(&r, idx, &cp);
+    for(n=cp.ordinal;n<i;n++)
+    {
+        if((rc = jsmn_skip_value(&r)) <= 0)
+            return rc < 0 ? rc : JSMN_ERROR_INVAL;
+    }
+    if((c = jsmn_reader_peek(&r)) <= 0 || c == ']' || c == '}')
+        return c < 0 ? c : JSMN_ERROR_INVAL;
+    *start = r.base + r.pos;
+    if((rc = jsmn_skip_value(&r)) <= 0)
+        return rc < 0 ? rc : JSMN_ERROR_INVAL;
+    *end = r.base + r.pos;
+    return 0;
+}
+
+static uint32_t jsmn_key_hash(const char* s, size_t len, uint32_t seed)
+{
+    uint32_t h = seed ^ (uint32_t)len * 0x9E3779B1u;
+    size_t i;
+
+    for(i=0;i<len;i++)
+        h = (h ^ (unsigned char)s[i]) * 0x01000193u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    return h ^ (h >> 13);
+}
+
+/* try seed on a table of mask + 1 slots. 1 if no two names collide */
+static int jsmn_keyset_fill(jsmn_keyset* ks, uint32_t seed, uint32_t mask)
+{
+    uint32_t h;
+    int i;
+
+    for(i=0;i<=(int)mask;i++)
+        ks->slots[i] = JSMN_KEY_UNKNOWN;
+    for(i=0;i<ks->num_names;i++)
+    {
+        h = jsmn_key_hash(ks->names[i], ks->lens[i], seed) & mask;
+        if(ks->slots[h] != JSMN_KEY_UNKNOWN)
+            return 0;
+        ks->slots[h] = (short)i;
+    }
+    ks->seed = seed;
+    ks->mask = mask;
+    return 1;
+}
+
+int jsmn_keyset_init(jsmn_keyset* ks, const char* const* names, int num_names)
+{
+    uint32_t size, seed;
+    short* slots;
+    int i, j;
+
+    memset(ks, 0, sizeof(*ks));
+    if(num_names < 0 || num_names > 0x7fff)
+        return JSMN_ERROR_INVAL;
+    ks->names = names;
+    ks->num_names = num_names;
+    if(!(ks->lens = malloc((num_names + 1) * sizeof(size_t))))
+        return JSMN_ERROR_NOMEM;
+    for(i=0;i<num_names;i++)
+    {
+        ks->lens[i] = strlen(names[i]);
+        for(j=0;j<i;j++)
+        {
+            if(ks->lens[i] == ks->lens[j] && !memcmp(names[i], names[j], ks->lens[i]))
+            {
+                jsmn_keyset_destroy(ks);
+                return JSMN_ERROR_INVAL;
+            }
+        }
+    }
+
+    /* a few hundred seeds per table size, then double the table */
+    for(size=4;size<2u*num_names;size*=2)
+        ;
+    for(;;size*=2)
+    {
+        if(!(slots = realloc(ks->slots, size * sizeof(short))))
+        {
+            jsmn_keyset_destroy(ks);
+            return JSMN_ERROR_NOMEM;
+        }
+        ks->slots = slots;
+        for(seed=1;seed<=256;seed++)
+            if(jsmn_keyset_fill(ks, seed, size - 1))
+                return 0;
+    }
+}
+
+void jsmn_keyset_destroy(jsmn_keyset* ks)
+{
+    free(ks->lens);
+    free(ks->slots);
+    ks->lens = NULL;
+    ks->slots = NULL;
+}
+
+int jsmn_keyset_id(const jsmn_keyset* ks, const char* key, size_t len)
+{
+    int i;
+
+    if(!ks->slots)
+        return JSMN_KEY_UNKNOWN;
+    i = ks->slots[jsmn_key_hash(key, len, ks->seed) & ks->mask];
+    if(i == JSMN_KEY_UNKNOWN || ks->lens[i] != len || memcmp(ks->names[i], key, len))
+        return JSMN_KEY_UNKNOWN;
+    return i;
+}
+
+int jsmn_keyset_token(const jsmn_keyset* ks, const char* json, jsmntok_t* key)
+{
+    return jsmn_keyset_id(ks, json + key->start, (size_t)(key->end - key->start));
+}
+
+int jsmn_keyset_match(const jsmn_keyset* ks, const char* json,
+    jsmntok_t* object, jsmntok_t** values)
+{
+    jsmntok_t* t;
+    jsmnint_t i;
+    int id, n = 0;
+
+    if(object->type != JSMN_OBJECT)
+        return JSMN_ERROR_WRONG_TYPE;
+    for(id=0;id<ks->num_names;id++)
+        values[id] = NULL;
+    for(i=0,t=object+1;i<object->size;i++,t=jsmn_obj_next(t))
+    {
+        if((id = jsmn_keyset_token(ks, json, t)) != JSMN_KEY_UNKNOWN)
+        {
+            values[id] = t + 1;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* grow parser->key_ids to at least need entries */
+static int jsmn_key_ids_reserve(jsmn_parser *parser, jsmnuint_t need)
+{
+    int32_t* ids;
+    jsmnuint_t sz;
+
+    if(need <= parser->key_ids_cap)
+        return 0;
+    sz = parser->key_ids_cap ? parser->key_ids_cap : 64;
+    while(sz < need)
+        sz *= 2;
+    if(!(ids = realloc(parser->key_ids, sz * sizeof(int32_t))))
+        return JSMN_ERROR_NOMEM;
+    parser->key_ids = ids;
+    parser->key_ids_cap = sz;
+    return 0;
+}
+
+static int jsmn_hashes_reserve(jsmn_parser *parser, jsmnuint_t need)
+{
+    uint64_t* hashes;
+    jsmnuint_t sz;
+
+    if(need <= parser->hashes_cap)
+        return 0;
+    sz = parser->hashes_cap ? parser->hashes_cap : 64;
+    while(sz < need)
+        sz *= 2;
+    if(!(hashes = realloc(parser->hashes, sz * sizeof(uint64_t))))
+        return JSMN_ERROR_NOMEM;
+    parser->hashes = hashes;
+    parser->hashes_cap = sz;
+    return 0;
+}
+
+void jsmn_intern_init(jsmn_intern* intern)
+{
+    memset(intern, 0, sizeof(*intern));
+}
+
+void jsmn_intern_destroy(jsmn_intern* intern)
+{
+    free(intern->text);
+    free(intern->keys);
+    free(intern->slots);
+    jsmn_intern_init(intern);
+}
+
+static int32_t jsmn_intern_slot(const jsmn_intern* intern, const char* key,
+    size_t len, uint32_t h)
+{
+    const jsmn_intern_key* k;
+    uint32_t i;
+    int32_t id;
+
+    for(i=h & intern->mask;(id = intern->slots[i]) != 0;i=(i+1) & intern->mask)
+    {
+        k = &intern->keys[id - 1];
+        if(k->hash == h && k->len == len && !memcmp(intern->text + k->start, key, len))
+            return (int32_t)i;
+    }
+    return (int32_t)i;
+}
+
+/* double the slot table and reinsert every key */
+static int jsmn_intern_rehash(jsmn_intern* intern)
+{
+    uint32_t size = intern->slots ? (intern->mask + 1) * 2 : 16, i;
+    int32_t* slots;
+    int32_t id;
+
+    if(!(slots = calloc(size, sizeof(int32_t))))
+        return JSMN_ERROR_NOMEM;
+    free(intern->slots);
+    intern->slots = slots;
+    intern->mask = size - 1;
+    for(id=0;id<intern->num_keys;id++)
+    {
+        for(i=intern->keys[id].hash & intern->mask;slots[i];i=(i+1) & intern->mask)
+            ;
+        slots[i] = id + 1;
+    }
+    return 0;
+}
+
+int32_t jsmn_intern_id(jsmn_intern* intern, const char* key, size_t len)
+{
+    jsmn_intern_key* keys;
+    uint32_t h = jsmn_key_hash(key, len, 0);
+    int32_t i, cap;
+    size_t sz;
+    char* text;
+
+    if(len > 0xffffffffu || intern->num_keys == 0x7fffffff)
+        return JSMN_ERROR_NOMEM;
+    /* keep the table at most half full */
+    if(!intern->slots || (uint32_t)intern->num_keys * 2 >= intern->mask)
+        if(jsmn_intern_rehash(intern))
+            return JSMN_ERROR_NOMEM;
+    i = jsmn_intern_slot(intern, key, len, h);
+    if(intern->slots[i])
+        return intern->slots[i] - 1;
+
+    if(intern->num_keys == intern->keys_cap)
+    {
+        cap = intern->keys_cap ? intern->keys_cap * 2 : 16;
+        if(!(keys = realloc(intern->keys, cap * sizeof(jsmn_intern_key))))
+            return JSMN_ERROR_NOMEM;
+        intern->keys = keys;
+        intern->keys_cap = cap;
+    }
+    if(intern->text_cap - intern->text_len < len)
+    {
+        for(sz=intern->text_cap ? intern->text_cap : 256;sz - intern->text_len < len;sz*=2)
+            ;
+        if(!(text = realloc(intern->text, sz)))
+            return JSMN_ERROR_NOMEM;
+        intern->text = text;
+        intern->text_cap = sz;
+    }
+    memcpy(intern->text + intern->text_len, key, len);
+    keys = &intern->keys[intern->num_keys];
+    keys->start = intern->text_len;
+    keys->len = (uint32_t)len;
+    keys->hash = h;
+    intern->text_len += len;
+    intern->slots[i] = ++intern->num_keys;
+    return intern->num_keys - 1;
+}
+
+int32_t jsmn_intern_find(const jsmn_intern* intern, const char* key, size_t len)
+{
+    int32_t i;
+
+    if(!intern->slots)
+        return JSMN_KEY_UNKNOWN;
+    i = jsmn_intern_slot(intern, key, len, jsmn_key_hash(key, len, 0));
+    return intern->slots[i] ? intern->slots[i] - 1 : JSMN_KEY_UNKNOWN;
+}
+
+const char* jsmn_intern_name(const jsmn_intern* intern, int32_t id, size_t* len)
+{
+    if(id < 0 || id >= intern->num_keys)
+        return NULL;
+    *len = intern->keys[id].len;
+    return intern->text + intern->keys[id].start;
+}
+
+jsmntok_t* jsmn_lookup_id(const jsmn_parser* parser, jsmntok_t* object, int32_t id)
+{
+    jsmntok_t* t;
+    jsmnint_t i;
+
+    if(!parser->key_ids || object->type != JSMN_OBJECT || id < 0)
+        return NULL;
+    for(i=0,t=object+1;i<object->size;i++,t=jsmn_obj_next(t))
+        if(parser->key_ids[t - parser->tokens] == id)
+            return t + 1;
+    return NULL;
+}
+
+int jsmn_shape_init(jsmn_shape* shape, const char* const* keys, int num_keys)
+{
+    int i;
+
+    memset(shape, 0, sizeof(*shape));
+    shape->lens = malloc((num_keys + 1) * sizeof(size_t));
+    shape->offsets = calloc(num_keys + 1, sizeof(jsmnint_t));
+    if(!shape->lens || !shape->offsets)
+    {
+        jsmn_shape_destroy(shape);
+        return JSMN_ERROR_NOMEM;
+    }
+    shape->keys = keys;
+    shape->num_keys = num_keys;
+    for(i=0;i<num_keys;i++)
+        shape->lens[i] = strlen(keys[i]);
+    return 0;
+}
+
+void jsmn_shape_destroy(jsmn_shape* shape)
+{
+    free(shape->lens);
+    free(shape->offsets);
+    shape->lens = NULL;
+    shape->offsets = NULL;
+}
+
+jsmntok_t* jsmn_shape_lookup(jsmn_shape* shape, const jsmn_parser* parser,
+    const char* json_text, jsmntok_t* object, int key)
+{
+    jsmntok_t* t;
+    jsmnint_t off;
+    size_t len;
+
+    if(key < 0 || key >= shape->num_keys || object->type != JSMN_OBJECT)
+        return NULL;
+    len = shape->lens[key];
+#ifdef JSMN_PARENT_LINKS
+    /* a token whose parent is object is one of its keys */
+    off = shape->offsets[key];
+    if(off > 0 && object - parser->tokens + off < (jsmnint_t)parser->toknext)
+    {
+        t = object + off;
+        if(t->parent == object - parser->tokens &&
+           t->end - t->start == (jsmnint_t)len &&
+           !memcmp(json_text + t->start, shape->keys[key], len))
+        {
+            shape->hits++;
+            return t + 1;
+        }
+    }
+#else
+    (void)parser;
+#endif
+    shape->misses++;
+    if(!(t = jsmn_lookup(json_text, object, shape->keys[key])))
+        return NULL;
+    shape->offsets[key] = (jsmnint_t)(t - 1 - object);
+    return t;
+}
+
+int jsmn_pool_init(jsmn_pool* pool, int max_idle)
+{
+    pool->num_idle = 0;
+    pool->max_idle = max_idle > 0 ? max_idle : 1;
+    pool->tokens_per_kb = 128 << 8; /* one token per 8 bytes to start */
+    pool->idle = malloc(pool->max_idle * sizeof(jsmn_parser*));
+    return pool->idle ? 0 : JSMN_ERROR_NOMEM;
+}
+
+void jsmn_pool_destroy(jsmn_pool* pool)
+{
+    while(pool->num_idle > 0)
+    {
+        jsmn_destroy(pool->idle[--pool->num_idle]);
+        free(pool->idle[pool->num_idle]);
+    }
+    free(pool->idle);
+    pool->idle = NULL;
+}
+
+jsmn_parser* jsmn_pool_get(jsmn_pool* pool, size_t len)
+{
+    jsmn_parser* parser;
+    uint64_t want;
+
+    if(pool->num_idle > 0)
+        parser = pool->idle[--pool->num_idle];
+    else
+    {
+        if(!(parser = malloc(sizeof(jsmn_parser))))
+            return NULL;
+        jsmn_init(parser);
+    }
+    jsmn_reset(parser);
+
+    /* predicted count plus a quarter, so a little variation does not
+       fall back to doubling */
+    want = (uint64_t)len * pool->tokens_per_kb >> 18;
+    want += want / 4 + 16;
+    if(want > (uint64_t)len + 16)
+        want = (uint64_t)len + 16;
+    if(want > (jsmnuint_t)-1)
+        want = (jsmnuint_t)-1;
+    if(jsmn_reserve(parser, (jsmnuint_t)want))
+    {
+        jsmn_destroy(parser);
+        free(parser);
+        return NULL;
+    }
+    return parser;
+}
+
+void jsmn_pool_put(jsmn_pool* pool, jsmn_parser* parser)
+{
+    uint64_t sample;
+
+    if(parser->pos > 0)
+    {
+        sample = ((uint64_t)parser->toknext << 18) / parser->pos;
+        if(sample > 1u << 19)
+            sample = 1u << 19;
+        /* moving average over about the last 8 documents */
+        pool->tokens_per_kb = (uint32_t)(pool->tokens_per_kb
+            - (pool->tokens_per_kb >> 3) + (sample >> 3));
+    }
+    if(pool->num_idle < pool->max_idle)
+        pool->idle[pool->num_idle++] = parser;
+    else
+    {
+        jsmn_destroy(parser);
+        free(parser);
+    }
+}
+
+typedef struct {
+    jsmntok_t* key; /* key in the new object, NULL if empty */
+    uint32_t hash;
+    int matched;
+} jsmn_diff_slot;
+
+typedef struct {
+    const char* old_json;
+    const char* new_json;
+    jsmn_diff_cb cb;
+    void* user;
+    char* path;
+    size_t path_len;
+    size_t path_cap;
+    jsmn_diff_slot* slots; /* one table per object being compared */
+    size_t num_slots;
+    size_t slots_cap;
+    int count;
+    jsmntok_t* old_root;
+    jsmntok_t* new_root;
+    jsmnint_t* old_next; /* per token from root, index after its subtree */
+    jsmnint_t* new_next;
+    const uint64_t* old_hashes; /* fingerprints from root, or NULL */
+    const uint64_t* new_hashes;
+} jsmn_diff_ctx;
+
+static int jsmn_diff_reserve(jsmn_diff_ctx* ctx, size_t path, size_t slots)
+{
+    char* p;
+    jsmn_diff_slot* s;
+    size_t sz;
+
+    if(ctx->path_len + path >= ctx->path_cap)
+    {
+        for(sz=ctx->path_cap ? ctx->path_cap : 256;ctx->path_len + path >= sz;sz*=2)
+            ;
+        if(!(p = realloc(ctx->path, sz)))
+            return JSMN_ERROR_NOMEM;
+        ctx->path = p;
+        ctx->path_cap = sz;
+    }
+    if(ctx->num_slots + slots > ctx->slots_cap)
+    {
+        for(sz=ctx->slots_cap ? ctx->slots_cap : 64;ctx->num_slots + slots > sz;sz*=2)
+            ;
+        if(!(s = realloc(ctx->slots, sz * sizeof(jsmn_diff_slot))))
+            return JSMN_ERROR_NOMEM;
+        ctx->slots = s;
+        ctx->slots_cap = sz;
+    }
+    return 0;
+}
+
+/* append "/" and the escaped key or index to the path */
+static int jsmn_diff_push(jsmn_diff_ctx* ctx, const char* key, size_t len)
+{
+    size_t i;
+
+    if(jsmn_diff_reserve(ctx, 2 * len + 2, 0))
+        return JSMN_ERROR_NOMEM;
+    ctx->path[ctx->path_len++] = '/';
+    for(i=0;i<len;i++)
+    {
+        if(key[i] == '~' || key[i] == '/')
+        {
+            ctx->path[ctx->path_len++] = '~';
+            ctx->path[ctx->path_len++] = key[i] == '~' ? '0' : '1';
+        }
+        else
+            ctx->path[ctx->path_len++] = key[i];
+    }
+    ctx->path[ctx->path_len] = '\0';
+    return 0;
+}
+
+static int jsmn_diff_emit(jsmn_diff_ctx* ctx, jsmndiff_t kind,
+    jsmntok_t* old_value, jsmntok_t* new_value)
+{
+    ctx->count++;
+    if(ctx->cb && ctx->cb(ctx->user, kind, ctx->path, old_value, new_value))
+        return JSMN_ERROR_STOPPED;
+    return 0;
+}
+
+/* table of the index after the subtree of every token under root, so
+   that stepping to the next sibling is one lookup however deep it is */
+static int jsmn_diff_skips(jsmntok_t* root, jsmnint_t** out)
+{
+    /* keys take a level of their own */
+    jsmnint_t open[2 * JSMN_MAX_DEPTH + 2], left[2 * JSMN_MAX_DEPTH + 2];
+    jsmnint_t *next = NULL, *p, i;
+    size_t cap = 0;
+    int depth = 0;
+
+    for(i=0;;i++)
+    {
+        if((size_t)i == cap)
+        {
+            cap = cap ? cap * 2 : 64;
+            if(!(p = realloc(next, cap * sizeof(*next))))
+            {
+                free(next);
+                return JSMN_ERROR_NOMEM;
+            }
+            next = p;
+        }
+        if(depth)
+            left[depth - 1]--;
+        if(root[i].size > 0)
+        {
+            if(depth == 2 * JSMN_MAX_DEPTH + 2)
+            {
+                free(next);
+                return JSMN_ERROR_INVAL;
+            }
+            open[depth] = i;
+            left[depth++] = root[i].size;
+            continue;
+        }
+        next[i] = i + 1;
+        while(depth && !left[depth - 1])
+            next[open[--depth]] = i + 1;
+        if(!depth)
+            break;
+    }
+    *out = next;
+    return 0;
+}
+
+static jsmntok_t* jsmn_diff_next_old(const jsmn_diff_ctx* ctx, jsmntok_t* t)
+{
+    return ctx->old_root + ctx->old_next[t - ctx->old_root];
+}
+
+static jsmntok_t* jsmn_diff_next_new(const jsmn_diff_ctx* ctx, jsmntok_t* t)
+{
+    return ctx->new_root + ctx->new_next[t - ctx->new_root];
+}
+
+static int jsmn_diff_value(jsmn_diff_ctx* ctx, jsmntok_t* a, jsmntok_t* b,
+    int depth);
+
+static int jsmn_diff_array(jsmn_diff_ctx* ctx, jsmntok_t* a, jsmntok_t* b,
+    int depth)
+{
+    jsmntok_t *ta = a + 1, *tb = b + 1;
+    size_t len = ctx->path_len;
+    jsmnint_t i;
+    char index[24], *c;
+    int r;
+
+    for(i=0;i<a->size || i<b->size;i++)
+    {
+        c = jsmn_format_uint64(index + sizeof(index), (uint64_t)i);
+        if((r = jsmn_diff_push(ctx, c, (size_t)(index + sizeof(index) - c))))
+            return r;
+        if(i >= b->size)
+            r = jsmn_diff_emit(ctx, JSMN_DIFF_REMOVED, ta, NULL);
+        else if(i >= a->size)
+            r = jsmn_diff_emit(ctx, JSMN_DIFF_ADDED, NULL, tb);
+        else
+            r = jsmn_diff_value(ctx, ta, tb, depth + 1);
+        if(r)
+            return r;
+        ctx->path[ctx->path_len = len] = '\0';
+        if(i < a->size)
+            ta = jsmn_diff_next_old(ctx, ta);
+        if(i < b->size)
+            tb = jsmn_diff_next_new(ctx, tb);
+    }
+    return 0;
+}
+
+/* slot of key in the table at base, holding it or empty */
+static jsmn_diff_slot* jsmn_diff_probe(jsmn_diff_ctx* ctx, size_t base,
+    size_t mask, const char* json, jsmntok_t* key, uint32_t h)
+{
+    jsmn_diff_slot* s;
+    size_t i;
+    jsmnint_t len = key->end - key->start;
+
+    for(i=h & mask;;i=(i+1) & mask)
+    {
+        s = &ctx->slots[base + i];
+        if(!s->key || (s->hash == h && s->key->end - s->key->start == len &&
+           !memcmp(ctx->new_json + s->key->start, json + key->start, len)))
+            return s;
+    }
+}
+
+static int jsmn_diff_object(jsmn_diff_ctx* ctx, jsmntok_t* a, jsmntok_t* b,
+    int depth)
+{
+    jsmn_diff_slot* s;
+    jsmntok_t* t;
+    size_t base = ctx->num_slots, mask, len = ctx->path_len;
+    uint32_t h;
+    jsmnint_t i;
+    int r = 0;
+
+    for(mask=7;mask < 2 * (size_t)b->size;mask=mask*2+1)
+        ;
+    if(jsmn_diff_reserve(ctx, 0, mask + 1))
+        return JSMN_ERROR_NOMEM;
+    memset(ctx->slots + base, 0, (mask + 1) * sizeof(jsmn_diff_slot));
+    ctx->num_slots += mask + 1;
+
+    /* with repeated keys the first wins, as in jsmn_lookup */
+    for(i=0,t=b+1;i<b->size;i++,t=jsmn_diff_next_new(ctx, t))
+    {
+        h = jsmn_key_hash(ctx->new_json + t->start, t->end - t->start, 0);
+        s = jsmn_diff_probe(ctx, base, mask, ctx->new_json, t, h);
+        if(!s->key)
+        {
+            s->key = t;
+            s->hash = h;
+        }
+    }
+    for(i=0,t=a+1;i<a->size && !r;i++,t=jsmn_diff_next_old(ctx, t))
+    {
+        h = jsmn_key_hash(ctx->old_json + t->start, t->end - t->start, 0);
+        s = jsmn_diff_probe(ctx, base, mask, ctx->old_json, t, h);
+        if((r = jsmn_diff_push(ctx, ctx->old_json + t->start, t->end - t->start)))
+            break;
+        if(s->key)
+        {
+            s->matched = 1;
+            r = jsmn_diff_value(ctx, t + 1, s->key + 1, depth + 1);
+        }
+        else
+            r = jsmn_diff_emit(ctx, JSMN_DIFF_REMOVED, t + 1, NULL);
+        ctx->path[ctx->path_len = len] = '\0';
+    }
+    for(i=0,t=b+1;i<b->size && !r;i++,t=jsmn_diff_next_new(ctx, t))
+    {
+        h = jsmn_key_hash(ctx->new_json + t->start, t->end - t->start, 0);
+        s = jsmn_diff_probe(ctx, base, mask, ctx->new_json, t, h);
+        if(s->key != t || s->matched)
+            continue;
+        if(!(r = jsmn_diff_push(ctx, ctx->new_json + t->start, t->end - t->start)))
+            r = jsmn_diff_emit(ctx, JSMN_DIFF_ADDED, NULL, t + 1);
+        ctx->path[ctx->path_len = len] = '\0';
+    }
+    ctx->num_slots = base;
+    return r;
+}
+
+static int jsmn_diff_value(jsmn_diff_ctx* ctx, jsmntok_t* a, jsmntok_t* b,
+    int depth)
+{
+    jsmnint_t len = a->end - a->start;
+
+    if(depth > JSMN_MAX_DEPTH)
+        return JSMN_ERROR_INVAL;
+    if(a->type != b->type)
+        return jsmn_diff_emit(ctx, JSMN_DIFF_CHANGED, a, b);
+    /* identical text is an identical subtree. different fingerprints
+       rule it out without reading the text */
+    if((!ctx->old_hashes || ctx->old_hashes[a - ctx->old_root] ==
+            ctx->new_hashes[b - ctx->new_root]) &&
+       len == b->end - b->start &&
+       !memcmp(ctx->old_json + a->start, ctx->new_json + b->start, len))
+        return 0;
+    if(a->type == JSMN_OBJECT)
+        return jsmn_diff_object(ctx, a, b, depth);
+    if(a->type == JSMN_ARRAY)
+        return jsmn_diff_array(ctx, a, b, depth);
+    return jsmn_diff_emit(ctx, JSMN_DIFF_CHANGED, a, b);
+}
+
+int jsmn_diff_hashed(const char* old_json, jsmntok_t* old_root,
+    const uint64_t* old_hashes, const char* new_json, jsmntok_t* new_root,
+    const uint64_t* new_hashes, jsmn_diff_cb cb, void* user)
+{
+    jsmn_diff_ctx ctx;
+    int r;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.old_json = old_json;
+    ctx.new_json = new_json;
+    ctx.cb = cb;
+    ctx.user = user;
+    ctx.old_root = old_root;
+    ctx.new_root = new_root;
+    if(old_hashes && new_hashes)
+    {
+        ctx.old_hashes = old_hashes;
+        ctx.new_hashes = new_hashes;
+    }
+    if(!(r = jsmn_diff_skips(old_root, &ctx.old_next)) &&
+       !(r = jsmn_diff_skips(new_root, &ctx.new_next)) &&
+       !(r = jsmn_diff_reserve(&ctx, 1, 0)))
+    {
+        ctx.path[0] = '\0';
+        r = jsmn_diff_value(&ctx, old_root, new_root, 0);
+    }
+    free(ctx.old_next);
+    free(ctx.new_next);
+    free(ctx.path);
+    free(ctx.slots);
+    return r ? r : ctx.count;
+}
+
+int jsmn_diff(const char* old_json, jsmntok_t* old_root,
+    const char* new_json, jsmntok_t* new_root, jsmn_diff_cb cb, void* user)
+{
+    return jsmn_diff_hashed(old_json, old_root, NULL, new_json, new_root,
+        NULL, cb, user);
+}
+
+static int jsmn_hex_digit(char c)
+{
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/* decode the escapes of len bytes of string token text into out, which
+   has room for len bytes. lone surrogates are encoded as 3 bytes like any
+   other code point. returns bytes written or (size_t)-1 */
+static size_t jsmn_unescape(const char* s, size_t len, char* out)
+{
+    const char* end = s + len;
+    char* o = out;
+    uint32_t c, lo;
+    int i, d;
+
+    while(s < end)
+    {
+        if(*s != '\\')
+        {
+            *o++ = *s++;
+            continue;
+        }
+        if(++s == end)
+            return (size_t)-1;
+        switch(*s)
+        {
+            case 'b': *o++ = '\b'; s++; continue;
+            case 'f': *o++ = '\f'; s++; continue;
+            case 'n': *o++ = '\n'; s++; continue;
+            case 'r': *o++ = '\r'; s++; continue;
+            case 't': *o++ = '\t'; s++; continue;
+            case 'u': break;
+            default: *o++ = *s++; continue;
+        }
+        if(end - s < 5)
+            return (size_t)-1;
+        for(c=0,i=1;i<5;i++)
+        {
+            if((d = jsmn_hex_digit(s[i])) < 0)
+                return (size_t)-1;
+            c = c << 4 | (uint32_t)d;
+        }
+        s += 5;
+        if(c >= 0xD800 && c < 0xDC00 && end - s >= 6 && s[0] == '\\' && s[1] == 'u')
+        {
+            for(lo=0,i=2;i<6 && (d = jsmn_hex_digit(s[i])) >= 0;i++)
+                lo = lo << 4 | (uint32_t)d;
+            if(i == 6 && lo >= 0xDC00 && lo < 0xE000)
+            {
+                c = 0x10000 + ((c - 0xD800) << 10) + (lo - 0xDC00);
+                s += 6;
+            }
+        }
+        if(c < 0x80)
+            *o++ = (char)c;
+        else if(c < 0x800)
+        {
+            *o++ = (char)(0xC0 | (c >> 6));
+            *o++ = (char)(0x80 | (c & 0x3F));
+        }
+        else if(c < 0x10000)
+        {
+            *o++ = (char)(0xE0 | (c >> 12));
+            *o++ = (char)(0x80 | ((c >> 6) & 0x3F));
+            *o++ = (char)(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            *o++ = (char)(0xF0 | (c >> 18));
+            *o++ = (char)(0x80 | ((c >> 12) & 0x3F));
+            *o++ = (char)(0x80 | ((c >> 6) & 0x3F));
+            *o++ = (char)(0x80 | (c & 0x3F));
+        }
+    }
+    return (size_t)(o - out);
+}
+
+enum {
+    JSMN_BIN_UINT = 0,
+    JSMN_BIN_NEGINT = 1,
+    JSMN_BIN_STR = 3,
+    JSMN_BIN_ARRAY = 4,
+    JSMN_BIN_MAP = 5
+};
+
+/* big endian n in size bytes */
+static void jsmn_bin_be(unsigned char* out, uint64_t n, int size)
+{
+    while(size-- > 0)
+    {
+        out[size] = (unsigned char)n;
+        n >>= 8;
+    }
+}
+
+/* size of the header for kind and n */
+static int jsmn_bin_head_size(jsmnbinary_t fmt, int kind, uint64_t n)
+{
+    if(fmt == JSMN_CBOR)
+        return n < 24 ? 1 : n <= 0xff ? 2 : n <= 0xffff ? 3 : n <= 0xffffffffu ? 5 : 9;
+    if(kind == JSMN_BIN_STR)
+        return n < 32 ? 1 : n <= 0xff ? 2 : n <= 0xffff ? 3 : 5;
+    return n < 16 ? 1 : n <= 0xffff ? 3 : 5;
+}
+
+/* write the header for a string, array or map of n items. room for
+   jsmn_bin_head_size bytes must be reserved */
+static void jsmn_bin_head(jsmn_writer* w, jsmnbinary_t fmt, int kind, uint64_t n)
+{
+    unsigned char* o = (unsigned char*)w->buf + w->len;
+    int size = jsmn_bin_head_size(fmt, kind, n);
+
+    if(fmt == JSMN_CBOR)
+    {
+        o[0] = (unsigned char)(kind << 5 | (size == 1 ? n : size == 2 ? 24 :
+            size == 3 ? 25 : size == 5 ? 26 : 27));
+    }
+    else if(kind == JSMN_BIN_STR)
+        o[0] = size == 1 ? 0xa0 | (unsigned char)n : size == 2 ? 0xd9 : size == 3 ? 0xda : 0xdb;
+    else if(kind == JSMN_BIN_ARRAY)
+        o[0] = size == 1 ? 0x90 | (unsigned char)n : size == 3 ? 0xdc : 0xdd;
+    else
+        o[0] = size == 1 ? 0x80 | (unsigned char)n : size == 3 ? 0xde : 0xdf;
+    if(size > 1)
+        jsmn_bin_be(o + 1, n, size - 1);
+    w->len += size;
+}
+
+static int jsmn_bin_int(jsmn_writer* w, jsmnbinary_t fmt, int64_t v)
+{
+    unsigned char* o;
+    uint64_t u;
+
+    if(jsmn_writer_reserve(w, 9))
+        return w->error;
+    o = (unsigned char*)w->buf + w->len;
+    if(fmt == JSMN_CBOR)
+    {
+        u = v < 0 ? (uint64_t)(-(v + 1)) : (uint64_t)v;
+        jsmn_bin_head(w, fmt, v < 0 ? JSMN_BIN_NEGINT : JSMN_BIN_UINT, u);
+        return 0;
+    }
+    if(v >= -32 && v < 128)
+    {
+        o[0] = (unsigned char)v;
+        w->len += 1;
+    }
+    else if(v >= 0)
+    {
+        u = (uint64_t)v;
+        o[0] = u <= 0xff ? 0xcc : u <= 0xffff ? 0xcd : u <= 0xffffffffu ? 0xce : 0xcf;
+        jsmn_bin_be(o + 1, u, 1 << (o[0] - 0xcc));
+        w->len += 1 + (1 << (o[0] - 0xcc));
+    }
+    else
+    {
+        o[0] = v >= -0x80 ? 0xd0 : v >= -0x8000 ? 0xd1 : v >= -0x80000000LL ? 0xd2 : 0xd3;
+        jsmn_bin_be(o + 1, (uint64_t)v, 1 << (o[0] - 0xd0));
+        w->len += 1 + (1 << (o[0] - 0xd0));
+    }
+    return 0;
+}
+
+static int jsmn_bin_double(jsmn_writer* w, jsmnbinary_t fmt, double d)
+{
+    uint64_t bits;
+
+    if(jsmn_writer_reserve(w, 9))
+        return w->error;
+    memcpy(&bits, &d, 8);
+    w->buf[w->len] = (char)(fmt == JSMN_CBOR ? 0xfb : 0xcb);
+    jsmn_bin_be((unsigned char*)w->buf + w->len + 1, bits, 8);
+    w->len += 9;
+    return 0;
+}
+
+static int jsmn_bin_string(jsmn_writer* w, jsmnbinary_t fmt, const char* s,
+    size_t len, int escaped)
+{
+    int head = jsmn_bin_head_size(fmt, JSMN_BIN_STR, len), size;
+    size_t n = len;
+
+    if(jsmn_writer_reserve(w, head + len))
+        return w->error;
+    if(!escaped || !memchr(s, '\\', len))
+        memcpy(w->buf + w->len + head, s, len);
+    else if((n = jsmn_unescape(s, len, w->buf + w->len + head)) == (size_t)-1)
+        return w->error = JSMN_ERROR_INVAL;
+    /* unescaping can shrink the text into a smaller header */
+    if((size = jsmn_bin_head_size(fmt, JSMN_BIN_STR, n)) != head)
+        memmove(w->buf + w->len + size, w->buf + w->len + head, n);
+    jsmn_bin_head(w, fmt, JSMN_BIN_STR, n);
+    w->len += n;
+    return 0;
+}
+
+static int jsmn_bin_primitive(jsmn_writer* w, jsmnbinary_t fmt,
+    const char* js, jsmntok_t* t)
+{
+    const char* s = js + t->start;
+    jsmnint_t len = t->end - t->start;
+    int64_t i;
+    double d;
+
+    if((len == 4 && (!memcmp(s, "null", 4) || !memcmp(s, "true", 4))) ||
+       (len == 5 && !memcmp(s, "false", 5)))
+    {
+        if(jsmn_writer_reserve(w, 1))
+            return w->error;
+        if(*s == 'n')
+            w->buf[w->len++] = (char)(fmt == JSMN_CBOR ? 0xf6 : 0xc0);
+        else
+            w->buf[w->len++] = (char)((fmt == JSMN_CBOR ? 0xf4 : 0xc2) + (*s == 't'));
+        return 0;
+    }
+    if(*s == '-' || (*s >= '0' && *s <= '9'))
+    {
+        if(jsmn_try_parse_int64(js, t, &i))
+            return jsmn_bin_int(w, fmt, i);
+        if(jsmn_try_parse_double(js, t, &d))
+            return jsmn_bin_double(w, fmt, d);
+    }
+    return jsmn_bin_string(w, fmt, s, len, 0);
+}
+
+/* returns tokens consumed */
+static jsmnint_t jsmn_bin_token(const char* js, jsmntok_t* t,
+    jsmnbinary_t fmt, jsmn_writer* w)
+{
+    jsmnint_t i, j, r;
+
+    switch(t->type)
+    {
+        case JSMN_OBJECT: case JSMN_ARRAY:
+            if(jsmn_writer_reserve(w, 9))
+                return w->error;
+            jsmn_bin_head(w, fmt, t->type == JSMN_OBJECT ? JSMN_BIN_MAP :
+                JSMN_BIN_ARRAY, (uint64_t)t->size);
+            for(i=0,j=1;i<t->size;i++)
+            {
+                /* keys are always strings */
+                if(t->type == JSMN_OBJECT)
+                {
+                    if(jsmn_bin_string(w, fmt, js + t[j].start,
+                            t[j].end - t[j].start, t[j].type == JSMN_STRING))
+                        return w->error;
+                    j++;
+                }
+                if((r = jsmn_bin_token(js, t + j, fmt, w)) < 0)
+                    return r;
+                j += r;
+            }
+            return j;
+        case JSMN_STRING:
+            return jsmn_bin_string(w, fmt, js + t->start, t->end - t->start, 1) ?
+                w->error : 1;
+        default:
+            return jsmn_bin_primitive(w, fmt, js, t) ? w->error : 1;
+    }
+}
+
+jsmnint_t jsmn_transcode_binary(const char* json_text, jsmntok_t* token,
+    jsmnbinary_t format, jsmn_writer* w)
+{
+    jsmnint_t n;
+
+    if(w->error)
+        return w->error;
+    /* a value is never larger than its text plus a 9 byte header per
+       token, so one reservation covers the whole output */
+    if(w->owns_buf)
+    {
+        n = (jsmnint_t)(jsmn_array_next(token) - token);
+        if(jsmn_writer_reserve(w, (size_t)(token->end - token->start) + 9 * (size_t)n))
+            return w->error;
+    }
+    return jsmn_bin_token(json_text, token, format, w);
+}
+
+static uint64_t jsmn_bin_read(const unsigned char* p, int size)
+{
+    uint64_t n = 0;
+
+    while(size-- > 0)
+        n = n << 8 | *p++;
+    return n;
+}
+
+/* kind of the item at p: JSMN_BIN_STR, _ARRAY or _MAP with n items or
+   payload bytes after head header bytes, JSMN_BIN_UINT for a primitive of
+   head bytes in total or -1 for a CBOR tag of head bytes. returns the kind,
+   JSMN_ERROR_PART or JSMN_ERROR_INVAL */
+static int jsmn_bin_item(const unsigned char* p, size_t avail,
+    jsmnbinary_t fmt, size_t* head, uint64_t* n)
+{
+    static const unsigned char msgpack_size[] = {
+        /* 0xc0 .. 0xdf: bytes after the type byte, 0xff invalid */
+        0, 0xff, 0, 0, 1, 2, 4, 1, 2, 4, 4, 8, 1, 2, 4, 8,
+        1, 2, 4, 8, 2, 3, 5, 9, 17, 1, 2, 4, 2, 4, 2, 4};
+    unsigned char b = p[0];
+    int major, ai, size;
+
+    if(fmt == JSMN_CBOR)
+    {
+        major = b >> 5;
+        ai = b & 31;
+        if(ai >= 28)
+            return JSMN_ERROR_INVAL;
+        size = ai < 24 ? 0 : 1 << (ai - 24);
+        if(avail < (size_t)size + 1)
+            return JSMN_ERROR_PART;
+        *head = (size_t)size + 1;
+        *n = size ? jsmn_bin_read(p + 1, size) : (uint64_t)ai;
+        switch(major)
+        {
+            case 2: case 3: return JSMN_BIN_STR;
+            case 4: return JSMN_BIN_ARRAY;
+            case 5: return JSMN_BIN_MAP;
+            case 6: return -1;
+            default: return JSMN_BIN_UINT;
+        }
+    }
+
+    if(b < 0x80 || b >= 0xe0)
+    {
+        *head = 1;
+        return JSMN_BIN_UINT;
+    }
+    if(b < 0xc0)
+    {
+        *head = 1;
+        *n = b & (b < 0xa0 ? 0x0f : 0x1f);
+        return b < 0x90 ? JSMN_BIN_MAP : b < 0xa0 ? JSMN_BIN_ARRAY : JSMN_BIN_STR;
+    }
+    if((size = msgpack_size[b - 0xc0]) == 0xff)
+        return JSMN_ERROR_INVAL;
+    if(avail < (size_t)size + 1)
+        return JSMN_ERROR_PART;
+    *head = (size_t)size + 1;
+    switch(b)
+    {
+        case 0xc4: case 0xc5: case 0xc6: case 0xd9: case 0xda: case 0xdb:
+            *n = jsmn_bin_read(p + 1, size);
+            return JSMN_BIN_STR;
+        case 0xdc: case 0xdd:
+            *n = jsmn_bin_read(p + 1, size);
+            return JSMN_BIN_ARRAY;
+        case 0xde: case 0xdf:
+            *n = jsmn_bin_read(p + 1, size);
+            return JSMN_BIN_MAP;
+        case 0xc7: case 0xc8: case 0xc9:
+            /* ext: length, type byte, data */
+            *head += 1 + jsmn_bin_read(p + 1, size);
+            return JSMN_BIN_UINT;
+        default:
+            return JSMN_BIN_UINT;
+    }
+}
+
+static jsmnint_t jsmn_parse_binary_items(jsmn_parser* parser,
+    const char* buf, size_t len, jsmnbinary_t format, jsmntok_t* tokens,
+    jsmnuint_t num_tokens)
+{
+    const unsigned char* p = (const unsigned char*)buf;
+    jsmnint_t open[JSMN_MAX_DEPTH], key[JSMN_MAX_DEPTH];
+    uint64_t left[JSMN_MAX_DEPTH], n = 0;
+    jsmnint_t count = parser->toknext, super;
+    jsmntok_t* t;
+    size_t pos = parser->pos, head;
+    int depth = 0, kind;
+
+    if(tokens)
+    {
+        parser->tokens = tokens;
+        parser->num_tokens = num_tokens;
+        parser->owns_tokens = 0;
+    }
+    else if(!parser->tokens && jsmn_reserve(parser, 64))
+        return JSMN_ERROR_NOMEM;
+
+    while(pos < len || depth > 0)
+    {
+        if(depth > 0 && left[depth - 1] == 0)
+        {
+            parser->tokens[open[--depth]].end = (jsmnint_t)pos;
+            continue;
+        }
+        if(pos >= len)
+            return JSMN_ERROR_PART;
+        if((kind = jsmn_bin_item(p + pos, len - pos, format, &head, &n)) < -1)
+            return kind;
+        if(kind == -1)
+        {
+            pos += head;
+            continue;
+        }
+        if(kind == JSMN_BIN_STR ? n > len - pos - head : head > len - pos)
+            return JSMN_ERROR_PART;
+
+        /* in a map even items are keys, odd items belong to the key */
+        super = -1;
+        if(depth > 0)
+        {
+            super = open[depth - 1];
+            if(parser->tokens[super].type == JSMN_OBJECT)
+            {
+                if(left[depth - 1] & 1)
+                    super = key[depth - 1];
+                else
+                    key[depth - 1] = (jsmnint_t)parser->toknext;
+            }
+            left[depth - 1]--;
+        }
+        if(!(t = jsmn_alloc_token(parser)))
+            return JSMN_ERROR_NOMEM;
+        count++;
+#ifdef JSMN_PARENT_LINKS
+        t->parent = super;
+#endif
+        if(kind == JSMN_BIN_ARRAY || kind == JSMN_BIN_MAP)
+        {
+            if(depth == JSMN_MAX_DEPTH || n > (uint64_t)len)
+                return n > (uint64_t)len ? JSMN_ERROR_PART : JSMN_ERROR_INVAL;
+            t->type = kind == JSMN_BIN_MAP ? JSMN_OBJECT : JSMN_ARRAY;
+            t->start = (jsmnint_t)pos;
+            t->size = (jsmnint_t)n;
+            open[depth] = (jsmnint_t)parser->toknext - 1;
+            left[depth++] = kind == JSMN_BIN_MAP ? 2 * n : n;
+            pos += head;
+        }
+        else if(kind == JSMN_BIN_STR)
+        {
+            jsmn_fill_token(t, JSMN_STRING, (jsmnint_t)(pos + head),
+                (jsmnint_t)(pos + head + n));
+            t->size = super != -1 && parser->tokens[super].type == JSMN_OBJECT;
+            pos += head + n;
+        }
+        else
+        {
+            jsmn_fill_token(t, JSMN_PRIMITIVE, (jsmnint_t)pos, (jsmnint_t)(pos + head));
+            t->size = super != -1 && parser->tokens[super].type == JSMN_OBJECT;
+            pos += head;
+        }
+    }
+    parser->pos = (jsmnuint_t)pos;
+    return count;
+}
+
+jsmnint_t jsmn_parse_binary(jsmn_parser* parser, const char* buf, size_t len,
+    jsmnbinary_t format, jsmntok_t* tokens, jsmnuint_t num_tokens)
+{
+    jsmnuint_t toknext = parser->toknext;
+    jsmnint_t r;
+
+    /* token offsets are jsmnint_t */
+    if(len > JSMN_MAX_LEN)
+        return JSMN_ERROR_INVAL;
+    /* the item count of a truncated container is only known from its
+       header, so nothing is kept of a failed call */
+    if((r = jsmn_parse_binary_items(parser, buf, len, format, tokens,
+            num_tokens)) < 0)
+        parser->toknext = toknext;
+    return r;
+}
+
+/* header byte and payload of a primitive token */
+static int jsmn_bin_prim(const char* buf, jsmntok_t* t, const unsigned char** p)
+{
+    if(t->type != JSMN_PRIMITIVE || t->end <= t->start)
+        return -1;
+    *p = (const unsigned char*)buf + t->start;
+    return **p;
+}
+
+int jsmn_binary_int64(const char* buf, jsmntok_t* token, jsmnbinary_t format,
+    int64_t* result)
+{
+    const unsigned char* p;
+    jsmnint_t size = token->end - token->start - 1;
+    uint64_t n;
+    int b;
+
+    if((b = jsmn_bin_prim(buf, token, &p)) < 0)
+        return 0;
+    if(format == JSMN_CBOR)
+    {
+        if(b >= 0x40 || (b & 31) >= 28)
+            return 0;
+        n = size ? jsmn_bin_read(p + 1, size) : (uint64_t)(b & 31);
+        if(n > INT64_MAX)
+            return 0;
+        *result = b < 0x20 ? (int64_t)n : -1 - (int64_t)n;
+        return 1;
+    }
+    if(b < 0x80 || b >= 0xe0)
+        *result = (signed char)b;
+    else if(b >= 0xcc && b <= 0xcf)
+    {
+        if((n = jsmn_bin_read(p + 1, size)) > INT64_MAX)
+            return 0;
+        *result = (int64_t)n;
+    }
+    else if(b >= 0xd0 && b <= 0xd3)
+    {
+        /* sign extend from size bytes */
+        n = jsmn_bin_read(p + 1, size) << (64 - 8 * size);
+        *result = (int64_t)n >> (64 - 8 * size);
+    }
+    else
+        return 0;
+    return 1;
+}
+
+int jsmn_binary_double(const char* buf, jsmntok_t* token, jsmnbinary_t format,
+    double* result)
+{
+    const unsigned char* p;
+    uint64_t bits;
+    uint32_t bits32;
+    float f;
+    int64_t i;
+    int b, e, m;
+
+    if(jsmn_binary_int64(buf, token, format, &i))
+    {
+        *result = (double)i;
+        return 1;
+    }
+    if((b = jsmn_bin_prim(buf, token, &p)) < 0)
+        return 0;
+    if(b == (format == JSMN_CBOR ? 0xfb : 0xcb))
+    {
+        bits = jsmn_bin_read(p + 1, 8);
+        memcpy(result, &bits, 8);
+    }
+    else if(b == (format == JSMN_CBOR ? 0xfa : 0xca))
+    {
+        bits32 = (uint32_t)jsmn_bin_read(p + 1, 4);
+        memcpy(&f, &bits32, 4);
+        *result = f;
+    }
+    else if(format == JSMN_CBOR && b == 0xf9)
+    {
+        /* half precision */
+        m = (int)jsmn_bin_read(p + 1, 2);
+        e = (m >> 10) & 0x1f;
+        *result = e == 0 ? ldexp(m & 0x3ff, -24) : e == 31 ?
+            ((m & 0x3ff) ? NAN : HUGE_VAL) : ldexp((m & 0x3ff) + 1024, e - 25);
+        if(m & 0x8000)
+            *result = -*result;
+    }
+    else
+        return 0;
+    return 1;
+}
+
+int jsmn_binary_bool(const char* buf, jsmntok_t* token, jsmnbinary_t format,
+    int* result)
+{
+    const unsigned char* p;
+    int b = jsmn_bin_prim(buf, token, &p) - (format == JSMN_CBOR ? 0xf4 : 0xc2);
+
+    if(b != 0 && b != 1)
+        return 0;
+    *result = b;
+    return 1;
+}
+
+int jsmn_binary_null(const char* buf, jsmntok_t* token, jsmnbinary_t format)
+{
+    const unsigned char* p;
+    int b = jsmn_bin_prim(buf, token, &p);
+
+    return format == JSMN_CBOR ? b == 0xf6 || b == 0xf7 : b == 0xc0;
+}
+
+static int jsmn_index_cmp_key(const jsmn_index_entry* a, const jsmn_index_entry* b,
+    jsmnindextype_t type)
+{
+    size_t n;
+    int r;
+
+    if(type == JSMN_INDEX_NUMBER)
+        return a->number < b->number ? -1 : a->number > b->number;
+    n = a->len < b->len ? a->len : b->len;
+    if((r = memcmp(a->text, b->text, n)))
+        return r;
+    return a->len < b->len ? -1 : a->len > b->len;
+}
+
+static int jsmn_index_cmp_string(const void* a, const void* b)
+{
+    int r = jsmn_index_cmp_key(a, b, JSMN_INDEX_STRING);
+    return r ? r : ((const jsmn_index_entry*)a)->ordinal <
+        ((const jsmn_index_entry*)b)->ordinal ? -1 : 1;
+}
+
+static int jsmn_index_cmp_number(const void* a, const void* b)
+{
+    int r = jsmn_index_cmp_key(a, b, JSMN_INDEX_NUMBER);
+    return r ? r : ((const jsmn_index_entry*)a)->ordinal <
+        ((const jsmn_index_entry*)b)->ordinal ? -1 : 1;
+}
+
+int jsmn_index_build(jsmn_index* index, const char* json,
+    jsmntok_t* array, const char* pointer, jsmnindextype_t type)
+{
+    jsmn_index_entry* e;
+    jsmntok_t *t, *k;
+    jsmnint_t i;
+
+    memset(index, 0, sizeof(*index));
+    index->type = type;
+    if(array->type != JSMN_ARRAY)
+        return JSMN_ERROR_WRONG_TYPE;
+    if(!(index->entries = malloc(((size_t)array->size + 1) * sizeof(jsmn_index_entry))))
+        return JSMN_ERROR_NOMEM;
+    for(i=0,t=array+1;i<array->size;i++,t=jsmn_array_next(t))
+    {
+        if(!(k = jsmn_pointer(json, t, pointer)))
+            continue;
+        e = &index->entries[index->count];
+        if(type == JSMN_INDEX_NUMBER)
+        {
+            if(!jsmn_try_parse_double(json, k, &e->number) || e->number != e->number)
+                continue;
+        }
+        else if(k->type != JSMN_STRING && k->type != JSMN_PRIMITIVE)
+            continue;
+        e->element = t;
+        e->text = json + k->start;
+        e->len = (size_t)(k->end - k->start);
+        e->ordinal = (size_t)i;
+        index->count++;
+    }
+    qsort(index->entries, index->count, sizeof(jsmn_index_entry),
+        type == JSMN_INDEX_NUMBER ? jsmn_index_cmp_number : jsmn_index_cmp_string);
+    return (int)index->count;
+}
+
+void jsmn_index_destroy(jsmn_index* index)
+{
+    free(index->entries);
+    index->entries = NULL;
+    index->count = 0;
+}
+
+/* first entry not less than key */
+static size_t jsmn_index_lower_bound(const jsmn_index* index,
+    const jsmn_index_entry* key)
+{
+    size_t lo = 0, hi = index->count, mid;
+
+    while(lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if(jsmn_index_cmp_key(&index->entries[mid], key, index->type) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static jsmntok_t* jsmn_index_at(const jsmn_index* index, const jsmn_index_entry* key)
+{
+    size_t i = jsmn_index_lower_bound(index, key);
+
+    if(i == index->count || jsmn_index_cmp_key(&index->entries[i], key, index->type))
+        return NULL;
+    return index->entries[i].element;
+}
+
+jsmntok_t* jsmn_index_find(const jsmn_index* index, const char* key, size_t len)
+{
+    jsmn_index_entry e;
+
+    if(index->type != JSMN_INDEX_STRING)
+        return NULL;
+    e.text = key;
+    e.len = len;
+    return jsmn_index_at(index, &e);
+}
+
+jsmntok_t* jsmn_index_find_number(const jsmn_index* index, double key)
+{
+    jsmn_index_entry e;
+
+    if(index->type != JSMN_INDEX_NUMBER)
+        return NULL;
+    e.number = key;
+    return jsmn_index_at(index, &e);
+}
+
+size_t jsmn_index_range(const jsmn_index* index, double lo, double hi,
+    size_t* first)
+{
+    jsmn_index_entry e;
+    size_t end, mid, top;
+
+    *first = 0;
+    if(index->type != JSMN_INDEX_NUMBER || !(lo <= hi))
+        return 0;
+    e.number = lo;
+    *first = jsmn_index_lower_bound(index, &e);
+    /* first entry above hi */
+    for(end=*first,top=index->count;end<top;)
+    {
+        mid = end + (top - end) / 2;
+        if(index->entries[mid].number <= hi)
+            end = mid + 1;
+        else
+            top = mid;
+    }
+    return end - *first;
+}
+
+int jsmn_elements_build(jsmn_elements* elements, jsmntok_t* tokens,
+    jsmnuint_t num_tokens)
+{
+#ifdef JSMN_PARENT_LINKS
+    jsmnuint_t i, total = 0;
+    jsmnint_t p;
+
+    memset(elements, 0, sizeof(*elements));
+    for(i=0;i<num_tokens;i++)
+        if(tokens[i].type == JSMN_ARRAY)
+            total += tokens[i].size;
+    elements->base = malloc((num_tokens + 1) * sizeof(jsmnuint_t));
+    elements->index = malloc((total + 1) * sizeof(jsmnuint_t));
+    if(!elements->base || !elements->index)
+    {
+        jsmn_elements_destroy(elements);
+        return JSMN_ERROR_NOMEM;
+    }
+    elements->tokens = tokens;
+    elements->num_tokens = num_tokens;
+
+    /* arrays get consecutive runs of index in token order. base is
+       advanced while filling and moved back after */
+    for(i=0,total=0;i<num_tokens;i++)
+    {
+        elements->base[i] = total;
+        if(tokens[i].type == JSMN_ARRAY)
+            total += tokens[i].size;
+    }
+    for(i=0;i<num_tokens;i++)
+        if((p = tokens[i].parent) >= 0 && tokens[p].type == JSMN_ARRAY)
+            elements->index[elements->base[p]++] = i;
+    for(i=0;i<num_tokens;i++)
+        if(tokens[i].type == JSMN_ARRAY)
+            elements->base[i] -= tokens[i].size;
+    return 0;
+#else
+    (void)tokens;
+    (void)num_tokens;
+    memset(elements, 0, sizeof(*elements));
+    return JSMN_ERROR_INVAL;
+#endif
+}
+
+void jsmn_elements_destroy(jsmn_elements* elements)
+{
+    free(elements->base);
+    free(elements->index);
+    elements->base = NULL;
+    elements->index = NULL;
+}
+
+jsmntok_t* jsmn_elements_at(const jsmn_elements* elements, jsmntok_t* array,
+    size_t i)
+{
+    if(array->type != JSMN_ARRAY || i >= (size_t)array->size ||
+       array < elements->tokens || array >= elements->tokens + elements->num_tokens)
+        return NULL;
+    return elements->tokens +
+        elements->index[elements->base[array - elements->tokens] + i];
+}
+
+jsmntok_t* jsmn_elements_find(const jsmn_elements* elements,
+    const char* json, jsmntok_t* token, const char* path_format, ...)
+{
+    va_list args;
+    jsmntok_t* t;
+
+    va_start(args, path_format);
+    t = jsmn_find_elements(json, token, elements, path_format, args);
+    va_end(args);
+    return t;
+}
@@ -2,6 +2,7 @@
 #define __JSMN_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,27 @@ extern "C" {
 #define JSMN_PARENT_LINKS
 #endif
 
+/**
+ * Offsets, sizes and token counts. Define JSMN_LARGE for 64 bit offsets to
+ * parse documents over 2 GB in one pass, at twice the memory per token.
+ */
+#ifdef JSMN_LARGE
+typedef int64_t jsmnint_t;
+typedef uint64_t jsmnuint_t;
+#else
+typedef int jsmnint_t;
+typedef unsigned int jsmnuint_t;
+#endif
+
+/* longest text whose offsets fit jsmnint_t. longer input is rejected with
+   JSMN_ERROR_INVAL */
+#define JSMN_MAX_LEN ((size_t)((jsmnuint_t)-1 >> 1))
+
+#ifndef JSMN_MAX_DEPTH
+/* nesting limit of the event parsers */
+#define JSMN_MAX_DEPTH 512
+#endif
+
 /**
  * JSON type identifier. Basic types are:
  *      o Object
@@ -40,7 +62,15 @@ enum jsmnerr {
     /* wrong type */
     JSMN_ERROR_WRONG_TYPE = -5,
     /* parsing failed */
-    JSMN_ERROR_NOPARSE = -6
+    JSMN_ERROR_NOPARSE = -6,
+    /* event handler returned non-zero */
+    JSMN_ERROR_STOPPED = -7,
+    /* read callback failed */
+    JSMN_ERROR_IO = -8,
+    /* parser->max_tokens or max_depth exceeded */
+    JSMN_ERROR_LIMIT = -9,
+    /* not an error. parser->max_bytes were processed, call again */
+    JSMN_YIELD = -10
 };
 
 const char* jsmn_strerror(int error_code);
@@ -53,25 +83,50 @@ const char* jsmn_strerror(int error_code);
  */
 typedef struct {
     jsmntype_t type;
-    int start;
-    int end;
-    int size;
+    jsmnint_t start;
+    jsmnint_t end;
+    jsmnint_t size;
 #ifdef JSMN_PARENT_LINKS
-    int parent;
+    jsmnint_t parent;
 #endif
 } jsmntok_t;
 
+/**
+ * Set parser->fingerprint to one of these before jsmn_parse to get a 64 bit
+ * structural hash of every token in parser->hashes, computed as each value
+ * completes. Whitespace does not change a hash. For a container it combines
+ * its children, for a key it covers the key and its value. UNORDERED gives
+ * objects the same hash whatever the order of their members.
+ * Needs JSMN_PARENT_LINKS.
+ */
+#define JSMN_FINGERPRINT_ORDERED 1
+#define JSMN_FINGERPRINT_UNORDERED 2
+
 /**
  * JSON parser. Contains an array of token blocks available. Also stores
  * the string being parsed now and current position in that string
  */
 typedef struct {
     jsmntok_t* tokens;
-    unsigned int num_tokens;
-    unsigned int pos; /* offset in the JSON string */
-    unsigned int toknext; /* next token to allocate */
-    int toksuper; /* superior token node, e.g parent object or array */
+    jsmnuint_t num_tokens;
+    jsmnuint_t pos; /* offset in the JSON string */
+    jsmnuint_t toknext; /* next token to allocate */
+    jsmnint_t toksuper; /* superior token node, e.g parent object or array */
     int owns_tokens;
+    char* map; /* text of jsmn_parse_file, freed by jsmn_destroy */
+    size_t map_len;
+    struct jsmn_intern* intern; /* optional, see jsmn_intern_init */
+    int32_t* key_ids; /* per token intern id of keys, -1 for other tokens */
+    jsmnuint_t key_ids_cap;
+    int fingerprint; /* 0 or JSMN_FINGERPRINT_ORDERED/UNORDERED */
+    uint64_t* hashes; /* per token fingerprint, see JSMN_FINGERPRINT_ORDERED */
+    jsmnuint_t hashes_cap;
+    /* budget, 0 for no limit. see jsmn_parse */
+    jsmnuint_t max_tokens;
+    int max_depth;
+    size_t max_bytes; /* per call */
+    int depth; /* open objects and arrays */
+    jsmnuint_t lexed; /* where a token cut by max_bytes continues, or 0 */
 } jsmn_parser;
 
 /**
@@ -79,19 +134,459 @@ typedef struct {
  */
 void jsmn_init(jsmn_parser *parser);
 void jsmn_destroy(jsmn_parser* parser);
+/* ready the parser for new text like jsmn_init but keep the tokens, key
+   ids and hashes it allocated for the next jsmn_parse_dynamic. intern and
+   fingerprint settings are kept */
+void jsmn_reset(jsmn_parser* parser);
+/* grow the tokens owned by the parser to hold at least num_tokens.
+   returns 0 or JSMN_ERROR_NOMEM */
+int jsmn_reserve(jsmn_parser* parser, jsmnuint_t num_tokens);
 
 /**
  * Run JSON parser. It parses a JSON data string into and array of tokens, each describing
  * a single JSON object. return >=0 is number of tokens. < 0 is error
+ *
+ * Set the budget fields of the parser after jsmn_init to bound a parse:
+ * more than max_tokens tokens or nesting deeper than max_depth fails with
+ * JSMN_ERROR_LIMIT, and dynamic token storage never grows past
+ * max_tokens. After max_bytes of input a call returns JSMN_YIELD, call it
+ * again with the same arguments to continue. A token longer than that is
+ * lexed over several calls.
  */
-int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
-        jsmntok_t *tokens, unsigned int num_tokens);
+jsmnint_t jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
+        jsmntok_t *tokens, jsmnuint_t num_tokens);
 /* dynamically allocate and resize tokens.
    they will be available on the parser when finished
    be sure to call jsmn_destroy to free the tokens */
-int jsmn_parse_dynamic(jsmn_parser *parser, const char *js, size_t len);
-int jsmn_parse_dynamic_str(jsmn_parser *parser, const char *js);
-int jsmn_parse_text(const char *js, jsmntok_t *tokens, unsigned int num_tokens);
+jsmnint_t jsmn_parse_dynamic(jsmn_parser *parser, const char *js, size_t len);
+jsmnint_t jsmn_parse_dynamic_str(jsmn_parser *parser, const char *js);
+jsmnint_t jsmn_parse_text(const char *js, jsmntok_t *tokens, jsmnuint_t num_tokens);
+/* memory map the file at path and parse it like jsmn_parse_dynamic. the text
+   is at parser->map, parser->map_len read only bytes without a NUL
+   terminator, until jsmn_destroy. the token helpers read only inside the
+   token, so none is needed. the parser is reset first, so it can parse one
+   file after another. returns number of tokens, JSMN_ERROR_IO if the file is empty
+   or cannot be mapped, or a parse error */
+jsmnint_t jsmn_parse_file(jsmn_parser *parser, const char *path);
+
+/* update the tokens of a completely parsed document after an edit of its
+   text: removed bytes at offset were replaced by inserted bytes. js/len is
+   the new text. only the smallest object or array that encloses the edit
+   is parsed again, tokens after it are shifted. edits outside of any
+   container parse the whole text. needs JSMN_PARENT_LINKS.
+   returns the new number of tokens or < 0 on error, in which case the
+   tokens are unchanged if the error came from the enclosing container */
+jsmnint_t jsmn_reparse(jsmn_parser *parser, const char *js, size_t len,
+        size_t offset, size_t removed, size_t inserted);
+
+/**
+ * Events of the tokenless parser. start/end are byte offsets with the same
+ * meaning as for tokens. START events cover the bracket, END events cover the
+ * whole object or array.
+ */
+typedef enum {
+    JSMN_EVENT_OBJECT_START = 1,
+    JSMN_EVENT_OBJECT_END = 2,
+    JSMN_EVENT_ARRAY_START = 3,
+    JSMN_EVENT_ARRAY_END = 4,
+    JSMN_EVENT_KEY = 5,
+    JSMN_EVENT_STRING = 6,
+    JSMN_EVENT_PRIMITIVE = 7
+} jsmnevent_t;
+
+/* return non-zero to stop parsing */
+typedef int (*jsmn_event_cb)(void* user, jsmnevent_t event,
+    jsmnint_t start, jsmnint_t end);
+
+/* parse without storing tokens, calling cb for every event.
+   memory is bounded by JSMN_MAX_DEPTH, deeper nesting fails with
+   JSMN_ERROR_LIMIT. returns the number of values (what jsmn_parse would
+   return) or < 0 on error.
+   include jsmn_sax.h for a variant with an inlined handler */
+jsmnint_t jsmn_parse_events(const char *js, size_t len, jsmn_event_cb cb, void* user);
+
+#ifndef JSMN_FILTER_MAX_CLAUSES
+/* clauses per jsmn_filter. at most 32 */
+#define JSMN_FILTER_MAX_CLAUSES 32
+#endif
+#if JSMN_FILTER_MAX_CLAUSES > 32
+#error "JSMN_FILTER_MAX_CLAUSES must be at most 32"
+#endif
+
+#ifndef JSMN_READER_BUFSIZ
+/* initial window size of jsmn_reader */
+#define JSMN_READER_BUFSIZ 65536
+#endif
+
+/* fill buf with up to size bytes. return bytes read, 0 at end of input
+   or < 0 on error */
+typedef int (*jsmn_read_cb)(void* user, char* buf, size_t size);
+
+/**
+ * One event of the pull parser.
+ * start/end    absolute byte offsets in the input, same meaning as for tokens
+ * text         start of the key/string/primitive inside the reader window.
+ *              valid until the next call on the reader. NULL for objects
+ *              and arrays
+ * depth        number of enclosing objects/arrays
+ */
+typedef struct {
+    jsmnevent_t type;
+    size_t start;
+    size_t end;
+    const char* text;
+    int depth;
+} jsmn_event;
+
+/**
+ * Pull parser over a sliding window of the input. Memory is the window
+ * plus JSMN_MAX_DEPTH levels of nesting, independent of document size.
+ * The window grows only when a single string or primitive does not fit.
+ */
+typedef struct {
+    char* buf;
+    size_t cap;
+    size_t len; /* bytes in window */
+    size_t pos; /* cursor in window */
+    size_t base; /* input offset of buf[0] */
+    jsmn_read_cb read;
+    void* user;
+    int eof;
+    int owns_buf;
+    int depth;
+    int expect_key;
+    size_t open[JSMN_MAX_DEPTH];
+    unsigned char is_object[JSMN_MAX_DEPTH];
+} jsmn_reader;
+
+/* read input through read_cb. buf/size is the window. if buf is NULL a
+   window of size (or JSMN_READER_BUFSIZ if 0) bytes is allocated and
+   grown as needed. returns 0 or JSMN_ERROR_NOMEM */
+int jsmn_reader_init(jsmn_reader* reader, jsmn_read_cb read_cb, void* user,
+    char* buf, size_t size);
+/* read a complete document already in memory */
+void jsmn_reader_init_buffer(jsmn_reader* reader, const char* js, size_t len);
+void jsmn_reader_destroy(jsmn_reader* reader);
+
+/* 1 if an event was stored, 0 at end of input, < 0 on error */
+int jsmn_next(jsmn_reader* reader, jsmn_event* event);
+/* skip the next value, including all children, without producing events.
+   if a key is expected the whole key/value pair is skipped.
+   1 if a value was skipped, 0 at end of object/array/input, < 0 on error */
+int jsmn_skip_value(jsmn_reader* reader);
+
+/**
+ * Comparison of a filter clause. EXISTS matches any value, including
+ * objects and arrays. The others compare numbers numerically and strings
+ * and other primitives bytewise. Values of a different kind never match.
+ */
+typedef enum {
+    JSMN_FILTER_EXISTS = 0,
+    JSMN_FILTER_EQ = 1,
+    JSMN_FILTER_NE = 2,
+    JSMN_FILTER_LT = 3,
+    JSMN_FILTER_LE = 4,
+    JSMN_FILTER_GT = 5,
+    JSMN_FILTER_GE = 6
+} jsmnfilterop_t;
+
+/* object key, or array index if key is NULL */
+typedef struct {
+    char* key;
+    size_t len;
+    int index;
+} jsmn_filter_step;
+
+typedef struct {
+    jsmnfilterop_t op;
+    jsmn_filter_step* steps;
+    int depth;
+    char* value; /* operand text. strings without quotes */
+    size_t value_len;
+    jsmntype_t value_type; /* JSMN_STRING or JSMN_PRIMITIVE */
+    int is_number;
+    double number;
+} jsmn_filter_clause;
+
+/**
+ * Compiled predicate: all clauses must match (AND). A record is rejected
+ * as soon as one clause fails, without scanning the rest of it. Once all
+ * have matched the rest is only checked to be valid. Missing paths fail.
+ */
+typedef struct {
+    jsmn_filter_clause clauses[JSMN_FILTER_MAX_CLAUSES];
+    int num_clauses;
+} jsmn_filter;
+
+void jsmn_filter_init(jsmn_filter* filter);
+void jsmn_filter_destroy(jsmn_filter* filter);
+
+/* add a clause. value is JSON text, e.g. "\"error\"" or "500", and is
+   ignored for JSMN_FILTER_EXISTS. path_format and its arguments are the
+   same as for jsmn_find.
+   returns 0, JSMN_ERROR_INVAL for a bad path or JSMN_ERROR_NOMEM */
+int jsmn_filter_add(jsmn_filter* filter, jsmnfilterop_t op,
+    const char* value, const char* path_format, ...);
+
+/* add clauses from text like
+     level == "error" && meta.latency > 500 && tags[0] && "odd key" != null
+   a clause without an operator is JSMN_FILTER_EXISTS.
+   returns 0, JSMN_ERROR_INVAL or JSMN_ERROR_NOMEM */
+int jsmn_filter_compile(jsmn_filter* filter, const char* expr);
+
+/* 1 if the single JSON value in js matches, else 0. invalid JSON never
+   matches */
+int jsmn_filter_match(const jsmn_filter* filter, const char* js, size_t len);
+
+/* find the next matching record of newline delimited JSON, starting at
+   *pos. stores the record byte range in start/end and advances *pos.
+   returns 1 if a record was found, 0 at end of input */
+int jsmn_filter_next(const jsmn_filter* filter, const char* js, size_t len,
+    size_t* pos, size_t* start, size_t* end);
+
+/**
+ * JSON writer. Output is appended to buf, len bytes are used. Commas and
+ * colons are inserted automatically. Errors are sticky: after the first
+ * failure every call returns the same error and writes nothing, so a
+ * sequence of calls only needs one check at the end.
+ */
+typedef struct {
+    char* buf;
+    size_t len;
+    size_t cap;
+    int owns_buf;
+    int error;
+    int indent; /* spaces per level. 0 writes compact output */
+    int depth;
+    int after_key;
+    unsigned char has_items[JSMN_MAX_DEPTH];
+} jsmn_writer;
+
+/* write into buf/size. if buf is NULL the writer allocates an initial
+   buffer of size bytes (or 256 if 0) and grows it as needed */
+int jsmn_writer_init(jsmn_writer* writer, char* buf, size_t size);
+void jsmn_writer_destroy(jsmn_writer* writer);
+/* forget written output but keep the buffer */
+void jsmn_writer_reset(jsmn_writer* writer);
+
+/* all return 0 or the sticky error, JSMN_ERROR_NOMEM if the buffer is full
+   or JSMN_ERROR_INVAL for unbalanced end calls */
+int jsmn_write_object_begin(jsmn_writer* writer);
+int jsmn_write_object_end(jsmn_writer* writer);
+int jsmn_write_array_begin(jsmn_writer* writer);
+int jsmn_write_array_end(jsmn_writer* writer);
+/* write an object key. the next call writes its value */
+int jsmn_write_key(jsmn_writer* writer, const char* key, size_t len);
+/* write a quoted and escaped string. s is not required to be NUL terminated */
+int jsmn_write_string(jsmn_writer* writer, const char* s, size_t len);
+int jsmn_write_int64(jsmn_writer* writer, int64_t value);
+/* shortest text that reads back as the same double, in the C locale
+   whatever LC_NUMERIC is. NaN and infinity are written as null */
+int jsmn_write_double(jsmn_writer* writer, double value);
+int jsmn_write_bool(jsmn_writer* writer, int value);
+int jsmn_write_null(jsmn_writer* writer);
+/* write text that is already valid JSON as one value */
+int jsmn_write_raw(jsmn_writer* writer, const char* text, size_t len);
+
+/* write the value at token, including children, as one value of writer.
+   string tokens are copied with their escapes as is. output is compact or
+   pretty printed according to writer->indent.
+   returns number of tokens consumed or < 0 on error */
+jsmnint_t jsmn_transcode(const char* json_text, jsmntok_t* token, jsmn_writer* writer);
+/* same as jsmn_transcode, streaming from the event parser without tokens.
+   returns number of values like jsmn_parse or < 0 on error */
+jsmnint_t jsmn_transcode_text(const char* js, size_t len, jsmn_writer* writer);
+/* remove whitespace outside of strings without tokenizing or validating.
+   appended as one value of writer. returns 0 or < 0 on error */
+int jsmn_minify_text(const char* js, size_t len, jsmn_writer* writer);
+
+typedef enum {
+    JSMN_MSGPACK = 0,
+    JSMN_CBOR = 1
+} jsmnbinary_t;
+
+/* append the value at token, including children, to the buffer of writer
+   as MessagePack or CBOR. the JSON state of writer is not used. strings
+   are unescaped to UTF-8, integers that fit int64_t are written as
+   integers, other numbers as 64 bit floats and unquoted text of the non
+   strict parser as strings. an owned buffer is grown once up front.
+   returns number of tokens consumed or < 0 on error */
+jsmnint_t jsmn_transcode_binary(const char* json_text, jsmntok_t* token,
+    jsmnbinary_t format, jsmn_writer* writer);
+
+/* parse MessagePack or CBOR in buf into tokens like jsmn_parse, so the
+   lookup and navigation functions work on the result. maps become
+   JSMN_OBJECT and arrays JSMN_ARRAY with start at their header and end
+   after their last item. text and byte strings become JSMN_STRING over
+   their payload bytes. every other item is a JSMN_PRIMITIVE over its
+   whole encoding, read it with jsmn_binary_int64 and friends. CBOR tags
+   are skipped, indefinite lengths are rejected. tokens NULL allocates
+   like jsmn_parse_dynamic. unlike jsmn_parse a JSMN_ERROR_NOMEM or
+   JSMN_ERROR_PART does not resume, the tokens of the failed call are
+   dropped so it can be repeated with more tokens or the whole input.
+   returns number of tokens, JSMN_ERROR_INVAL if len exceeds JSMN_MAX_LEN
+   or < 0 on another error */
+jsmnint_t jsmn_parse_binary(jsmn_parser* parser, const char* buf, size_t len,
+    jsmnbinary_t format, jsmntok_t* tokens, jsmnuint_t num_tokens);
+/* read a primitive token of jsmn_parse_binary. return 1 on success or 0
+   if the token is not of that type. integers read as doubles */
+int jsmn_binary_int64(const char* buf, jsmntok_t* token, jsmnbinary_t format,
+    int64_t* result);
+int jsmn_binary_double(const char* buf, jsmntok_t* token, jsmnbinary_t format,
+    double* result);
+int jsmn_binary_bool(const char* buf, jsmntok_t* token, jsmnbinary_t format,
+    int* result);
+/* 1 for nil, null or undefined */
+int jsmn_binary_null(const char* buf, jsmntok_t* token, jsmnbinary_t format);
+
+/* same layout as struct iovec so an array can be passed to writev */
+typedef struct {
+    void* iov_base;
+    size_t iov_len;
+} jsmn_iovec;
+
+typedef enum {
+    JSMN_PATCH_ADD = 0,
+    JSMN_PATCH_REPLACE = 1,
+    JSMN_PATCH_REMOVE = 2
+} jsmnpatchop_t;
+
+/* replace original bytes [start, end) with len bytes at offset text of
+   the patch text buffer. inserts have start == end. members removed from
+   and inserted into a container record it, so commas can be placed when
+   the patch is written */
+typedef struct {
+    jsmnint_t start;
+    jsmnint_t end;
+    size_t text;
+    size_t len;
+    jsmntok_t* container; /* NULL for other edits */
+    jsmnint_t index; /* removed member or insert position in container */
+    jsmnint_t first, last; /* byte range of a removed member */
+    int comma; /* insert needs a comma: 1 before, 2 after, 3 both */
+} jsmn_splice;
+
+/**
+ * Edit a parsed document as byte range splices. Unchanged bytes are never
+ * copied until the result is written, so the cost depends on the size of
+ * the edits, not of the document. All pointers refer to the original
+ * document. Edits must not overlap, e.g. a value and one of its children,
+ * jsmn_patch_op rejects one that does.
+ */
+typedef struct {
+    const char* json;
+    size_t len;
+    jsmntok_t* root;
+    jsmn_splice* splices;
+    size_t num_splices;
+    size_t cap;
+    jsmn_writer text; /* replacement bytes */
+} jsmn_patch;
+
+/* root is the first token of json, len its length */
+int jsmn_patch_init(jsmn_patch* patch, const char* json, size_t len,
+    jsmntok_t* root);
+void jsmn_patch_destroy(jsmn_patch* patch);
+
+/* add an RFC 6902 style operation. value is JSON text and is ignored for
+   remove. add to an existing object member replaces it, array index "-"
+   appends. pointers and indexes refer to the original document, commas
+   are placed when the patch is written. returns 0, JSMN_ERROR_NOFOUND if
+   the pointer does not resolve, JSMN_ERROR_INVAL if the edit overlaps an
+   earlier one, e.g. changes a removed value or adds the same member twice,
+   or JSMN_ERROR_NOMEM. the patch is unchanged on error */
+int jsmn_patch_op(jsmn_patch* patch, jsmnpatchop_t op, const char* pointer,
+    const char* value, size_t value_len);
+
+/* size in bytes of the patched document */
+size_t jsmn_patch_size(jsmn_patch* patch);
+/* append the patched document to writer as one value.
+   returns 0, JSMN_ERROR_INVAL for overlapping edits or JSMN_ERROR_NOMEM */
+int jsmn_patch_write(jsmn_patch* patch, jsmn_writer* writer);
+/* describe the patched document as pieces of the original text and of the
+   patch text buffer without copying. valid until the patch is changed.
+   returns number of entries used, JSMN_ERROR_INVAL for overlapping edits
+   or JSMN_ERROR_NOMEM if max_iov is too small */
+int jsmn_patch_iovec(jsmn_patch* patch, jsmn_iovec* iov, int max_iov);
+
+/* fast 64 bit hash of len bytes, not cryptographic */
+uint64_t jsmn_hash(const void* data, size_t len, uint64_t seed);
+
+/**
+ * Token array loaded from a cache file. tokens points into a private
+ * (copy on write) mapping of the file and is valid until jsmn_cache_close.
+ */
+typedef struct {
+    jsmntok_t* tokens;
+    jsmnuint_t num_tokens;
+    void* map;
+    size_t map_len;
+} jsmn_cache;
+
+/* write tokens of js with a hash of js and the build flags to path.
+   returns 0 or JSMN_ERROR_IO */
+int jsmn_cache_save(const char* path, const char* js, size_t len,
+    const jsmntok_t* tokens, jsmnuint_t num_tokens);
+/* map the cache at path if it was written for exactly this js and for a
+   library built with the same flags. the tokens are checked against the
+   checksum saved with them and to form a valid tree within js. returns 0,
+   JSMN_ERROR_IO if the file cannot be read or JSMN_ERROR_INVAL if it is
+   stale, incompatible or corrupt */
+int jsmn_cache_load(jsmn_cache* cache, const char* path,
+    const char* js, size_t len);
+void jsmn_cache_close(jsmn_cache* cache);
+
+/**
+ * Sparse seek index over the elements of a top level array. Inside the
+ * array, between two elements, the lexer state is only "depth 1, value
+ * expected", so a checkpoint is the byte offset of an element and its
+ * ordinal. Checkpoints are at least interval bytes apart.
+ */
+typedef struct {
+    uint64_t offset;
+    uint64_t ordinal;
+} jsmn_checkpoint;
+
+typedef struct {
+    jsmn_checkpoint* points;
+    size_t num_points;
+    size_t cap;
+    uint64_t interval;
+    uint64_t count; /* elements in the array */
+    uint64_t array_start; /* offset of the '[' */
+    uint64_t text_len; /* input size and checksum, to reject a stale index */
+    uint64_t text_hash;
+} jsmn_seek_index;
+
+/* scan the top level array read by reader, a fresh reader from
+   jsmn_reader_init or jsmn_reader_init_buffer, skipping each element.
+   returns 0, JSMN_ERROR_WRONG_TYPE if the input is not an array or another
+   reader error */
+int jsmn_seek_index_build(jsmn_seek_index* index, jsmn_reader* reader,
+    uint64_t interval);
+void jsmn_seek_index_destroy(jsmn_seek_index* index);
+/* returns 0 or JSMN_ERROR_IO. load takes the indexed text and also returns
+   JSMN_ERROR_INVAL for a file that is not a well formed index or was built
+   for a different text, and JSMN_ERROR_NOMEM. js may be NULL when the text
+   is only read as a stream, then only its length is compared */
+int jsmn_seek_index_save(const jsmn_seek_index* index, const char* path);
+int jsmn_seek_index_load(jsmn_seek_index* index, const char* path,
+    const char* js, size_t len);
+/* nearest checkpoint at or before element i. returns 0 or
+   JSMN_ERROR_NOFOUND if i is past the end of the array */
+int jsmn_seek_index_find(const jsmn_seek_index* index, uint64_t i,
+    jsmn_checkpoint* checkpoint);
+/* continue reading inside the indexed array at checkpoint. the input of
+   reader must start at checkpoint->offset. jsmn_skip_value moves from
+   element to element, jsmn_next reports absolute offsets */
+void jsmn_reader_resume(jsmn_reader* reader, const jsmn_seek_index* index,
+    const jsmn_checkpoint* checkpoint);
+/* byte range of element i of the indexed array in js, parsing only from the
+   nearest checkpoint. parse js + *start, *end - *start bytes to get its
+   tokens. returns 0, JSMN_ERROR_INVAL if len does not match the index,
+   JSMN_ERROR_NOFOUND or a parse error */
+int jsmn_seek_element(const jsmn_seek_index* index, const char* js,
+    size_t len, uint64_t i, size_t* start, size_t* end);
 
 /* assume token is an JSMN_OBJECT. return value for key_name if found
    else return NULL */
@@ -154,6 +649,11 @@ char* jsmn_string(const char* json_text, jsmntok_t* token);
 jsmntok_t* jsmn_find(
     const char* json, jsmntok_t* token, const char* path_format, ...);
 
+/* try to goto the value described by a JSON Pointer (RFC 6901) such as
+   "/data/0/weather". "" is token itself. returns NULL if not found */
+jsmntok_t* jsmn_pointer(
+    const char* json, jsmntok_t* token, const char* pointer);
+
 /* find and copy string value */
 char* jsmn_find_string_copy(
     const char* json, jsmntok_t* token,
@@ -162,6 +662,261 @@ char* jsmn_find_string_copy(
 /* 0 on success, 1 on failure to parse */
 int jsmn_try_parse_double(const char* text, jsmntok_t* token, double* result);
 double jsmn_parse_double(const char* text, jsmntok_t* token);
+/* 1 on success, 0 if token is not a base 10 integer or overflows int64_t */
+int jsmn_try_parse_int64(const char* text, jsmntok_t* token, int64_t* result);
+
+/**
+ * Column type for jsmn_extract_columns.
+ *      o DOUBLE values is a double*
+ *      o INT64  values is an int64_t*
+ *      o STRING values is a jsmnstr_t* pointing into the json text
+ */
+typedef enum {
+    JSMN_COLUMN_DOUBLE = 0,
+    JSMN_COLUMN_INT64 = 1,
+    JSMN_COLUMN_STRING = 2
+} jsmncoltype_t;
+
+/* zero copy string view. text is json_text + start, length end - start */
+typedef struct {
+    jsmnint_t start;
+    jsmnint_t end;
+} jsmnstr_t;
+
+/**
+ * One output column of jsmn_extract_columns.
+ * key      field name to read from every object
+ * type     conversion applied to the value
+ * values   buffer with room for array->size values of type
+ * valid    null mask with room for array->size bytes. 1 if the field was
+ *          present and converted, else 0 and values[row] is zeroed. may be NULL
+ */
+typedef struct {
+    const char* key;
+    jsmncoltype_t type;
+    void* values;
+    unsigned char* valid;
+} jsmncolumn_t;
+
+/* assume token is a JSMN_ARRAY of JSMN_OBJECTs. fill every column with one
+   row per array element in a single sequential sweep over the tokens.
+   elements that are not objects produce a null row. a key that repeats
+   in an object takes its last value, null if that one does not convert.
+   returns number of rows or JSMN_ERROR_WRONG_TYPE if token is not an array */
+jsmnint_t jsmn_extract_columns(
+    const char* json_text,
+    jsmntok_t* token,
+    jsmncolumn_t* columns,
+    size_t num_columns);
+
+/* id of a key that is not in the key set */
+#define JSMN_KEY_UNKNOWN -1
+
+/**
+ * Set of key names compiled into a perfect hash table. Matching a key costs
+ * one hash and one compare. names are not copied and must outlive the set.
+ * Keys are compared as raw JSON text, as in jsmn_lookup.
+ */
+typedef struct {
+    const char* const* names;
+    size_t* lens;
+    int num_names;
+    uint32_t seed;
+    uint32_t mask;
+    short* slots; /* mask + 1 entries, name index or JSMN_KEY_UNKNOWN */
+} jsmn_keyset;
+
+/* returns 0, JSMN_ERROR_INVAL for duplicate names or JSMN_ERROR_NOMEM */
+int jsmn_keyset_init(jsmn_keyset* keyset, const char* const* names, int num_names);
+void jsmn_keyset_destroy(jsmn_keyset* keyset);
+/* index of key in names or JSMN_KEY_UNKNOWN */
+int jsmn_keyset_id(const jsmn_keyset* keyset, const char* key, size_t len);
+/* same for a key token */
+int jsmn_keyset_token(const jsmn_keyset* keyset, const char* json_text,
+    jsmntok_t* key);
+/* one pass over object: values[id] is the value of names[id] or NULL.
+   values has room for num_names entries. if a key repeats the last value
+   wins. returns number of known keys seen or JSMN_ERROR_WRONG_TYPE */
+int jsmn_keyset_match(const jsmn_keyset* keyset, const char* json_text,
+    jsmntok_t* object, jsmntok_t** values);
+
+/**
+ * Shape cache for lookups on objects that repeat the same keys in the same
+ * order. The token offset of each key within the last object it was found
+ * in is remembered and tried first on the next object: a hit costs one
+ * parent check and one memcmp. A miss falls back to jsmn_lookup and
+ * learns the new offset. keys are not copied and must outlive the shape.
+ */
+typedef struct {
+    const char* const* keys;
+    size_t* lens;
+    jsmnint_t* offsets; /* key token - object per key, 0 if not seen yet */
+    int num_keys;
+    unsigned long hits;
+    unsigned long misses;
+} jsmn_shape;
+
+/* returns 0 or JSMN_ERROR_NOMEM */
+int jsmn_shape_init(jsmn_shape* shape, const char* const* keys, int num_keys);
+void jsmn_shape_destroy(jsmn_shape* shape);
+/* value of keys[key] in object or NULL. object is a token of parser.
+   if a key repeats in object either value may be returned */
+jsmntok_t* jsmn_shape_lookup(jsmn_shape* shape, const jsmn_parser* parser,
+    const char* json_text, jsmntok_t* object, int key);
+
+/**
+ * Table of key strings that lives across parses and maps each distinct key
+ * to a stable id, 0, 1, 2... in order of first appearance. Set
+ * parser->intern before jsmn_parse and every object key gets its id in
+ * parser->key_ids[token index], so later lookups compare integers.
+ */
+typedef struct {
+    size_t start; /* offset in text */
+    uint32_t len;
+    uint32_t hash;
+} jsmn_intern_key;
+
+typedef struct jsmn_intern {
+    char* text; /* key bytes, back to back */
+    size_t text_len;
+    size_t text_cap;
+    jsmn_intern_key* keys; /* by id */
+    int32_t num_keys;
+    int32_t keys_cap;
+    int32_t* slots; /* open addressing, id + 1 or 0 if empty */
+    uint32_t mask;
+} jsmn_intern;
+
+void jsmn_intern_init(jsmn_intern* intern);
+void jsmn_intern_destroy(jsmn_intern* intern);
+/* id of key, added if new. returns id or JSMN_ERROR_NOMEM */
+int32_t jsmn_intern_id(jsmn_intern* intern, const char* key, size_t len);
+/* id of key or JSMN_KEY_UNKNOWN, does not add */
+int32_t jsmn_intern_find(const jsmn_intern* intern, const char* key, size_t len);
+/* text of id, not NUL terminated */
+const char* jsmn_intern_name(const jsmn_intern* intern, int32_t id, size_t* len);
+/* assume object is a JSMN_OBJECT parsed by parser with an intern table.
+   return the value of the key with id or NULL */
+jsmntok_t* jsmn_lookup_id(const jsmn_parser* parser, jsmntok_t* object, int32_t id);
+
+/**
+ * Pool of parsers that keep their token storage between uses, for servers
+ * that parse one document per request. The first capacity of a parser is
+ * predicted from the text length and a moving average of tokens per byte
+ * over recent documents, so warm parsers parse without allocating.
+ * A pool is not locked: keep one per thread.
+ */
+typedef struct {
+    jsmn_parser** idle;
+    int num_idle;
+    int max_idle;
+    uint32_t tokens_per_kb; /* moving average, 1/256 token units */
+} jsmn_pool;
+
+/* returns 0 or JSMN_ERROR_NOMEM */
+int jsmn_pool_init(jsmn_pool* pool, int max_idle);
+/* frees idle parsers. parsers still out must be given back first */
+void jsmn_pool_destroy(jsmn_pool* pool);
+/* reset parser with room for the tokens expected in len bytes, or NULL */
+jsmn_parser* jsmn_pool_get(jsmn_pool* pool, size_t len);
+/* learn from the text parser consumed and keep it for the next get */
+void jsmn_pool_put(jsmn_pool* pool, jsmn_parser* parser);
+
+typedef enum {
+    JSMN_DIFF_ADDED = 1,
+    JSMN_DIFF_REMOVED = 2,
+    JSMN_DIFF_CHANGED = 3
+} jsmndiff_t;
+
+/* one difference. path is a JSON Pointer (RFC 6901) valid during the call.
+   old is NULL for ADDED and new NULL for REMOVED. return non-zero to stop */
+typedef int (*jsmn_diff_cb)(void* user, jsmndiff_t kind, const char* path,
+    jsmntok_t* old_value, jsmntok_t* new_value);
+
+/* compare the value at old_root in old_json with new_root in new_json.
+   identical byte ranges are skipped without descending, object members
+   are matched through a hash table and array elements by index, and
+   siblings are stepped over through a table built once per document, so
+   cost is about linear in the size of the documents. a value whose type or
+   text differs is reported as CHANGED, not its children. returns the
+   number of differences, JSMN_ERROR_STOPPED, JSMN_ERROR_NOMEM or
+   JSMN_ERROR_INVAL if nested deeper than JSMN_MAX_DEPTH */
+int jsmn_diff(const char* old_json, jsmntok_t* old_root,
+    const char* new_json, jsmntok_t* new_root, jsmn_diff_cb cb, void* user);
+/* jsmn_diff with the fingerprints of both documents, parsed with the same
+   parser->fingerprint mode. hashes[0] belongs to the root token, e.g.
+   parser->hashes + (root - parser->tokens). subtrees whose fingerprints
+   differ are descended without comparing their text first */
+int jsmn_diff_hashed(const char* old_json, jsmntok_t* old_root,
+    const uint64_t* old_hashes, const char* new_json, jsmntok_t* new_root,
+    const uint64_t* new_hashes, jsmn_diff_cb cb, void* user);
+
+typedef enum {
+    JSMN_INDEX_STRING = 0, /* raw text of a string or primitive key */
+    JSMN_INDEX_NUMBER = 1 /* primitive keys read as double */
+} jsmnindextype_t;
+
+typedef struct {
+    jsmntok_t* element;
+    const char* text; /* key text, STRING index */
+    size_t len;
+    double number; /* key value, NUMBER index */
+    size_t ordinal; /* position in the array, orders equal keys */
+} jsmn_index_entry;
+
+/**
+ * Secondary index over an array of objects, sorted on the value at a key
+ * path of each element. Point lookups and numeric range scans are binary
+ * searches. Holds pointers into the tokens and text, which must outlive
+ * the index.
+ */
+typedef struct {
+    jsmn_index_entry* entries; /* sorted by key, then array order */
+    size_t count;
+    jsmnindextype_t type;
+} jsmn_index;
+
+/* index the elements of array on the value at pointer (RFC 6901, relative
+   to each element, e.g. "/id"). elements without a usable key are left
+   out. returns number of entries, JSMN_ERROR_WRONG_TYPE if array is not a
+   JSMN_ARRAY or JSMN_ERROR_NOMEM */
+int jsmn_index_build(jsmn_index* index, const char* json_text,
+    jsmntok_t* array, const char* pointer, jsmnindextype_t type);
+void jsmn_index_destroy(jsmn_index* index);
+/* first element in array order whose key is the given raw text or number,
+   or NULL */
+jsmntok_t* jsmn_index_find(const jsmn_index* index, const char* key, size_t len);
+jsmntok_t* jsmn_index_find_number(const jsmn_index* index, double key);
+/* entries with lo <= key <= hi are entries[*first] onwards. returns how
+   many */
+size_t jsmn_index_range(const jsmn_index* index, double lo, double hi,
+    size_t* first);
+
+/**
+ * Element table for O(1) jsmn_array_at over a token array: the token index
+ * of every array element, grouped by array in order. Built in one pass
+ * over the tokens, without the text, for as long as they do not change.
+ * Element i of any array can be found directly, so parallel consumers can
+ * split an array into ranges without walking it.
+ */
+typedef struct {
+    jsmntok_t* tokens;
+    jsmnuint_t num_tokens;
+    jsmnuint_t* base; /* per token, position of its first element in index */
+    jsmnuint_t* index;
+} jsmn_elements;
+
+/* returns 0, JSMN_ERROR_NOMEM or JSMN_ERROR_INVAL without
+   JSMN_PARENT_LINKS */
+int jsmn_elements_build(jsmn_elements* elements, jsmntok_t* tokens,
+    jsmnuint_t num_tokens);
+void jsmn_elements_destroy(jsmn_elements* elements);
+/* jsmn_array_at for an array among the tokens of elements */
+jsmntok_t* jsmn_elements_at(const jsmn_elements* elements, jsmntok_t* array,
+    size_t i);
+/* jsmn_find with 'a' steps through jsmn_elements_at */
+jsmntok_t* jsmn_elements_find(const jsmn_elements* elements,
+    const char* json, jsmntok_t* token, const char* path_format, ...);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,793 @@
+#ifndef __JSMN_HPP_
+#define __JSMN_HPP_
+
+/**
+ * Header-only C++17 parser. Options that the C library takes from
+ * #defines are template parameters here, so a strict and a lenient parser
+ * can live in one binary:
+ *
+ *   jsmn::document<jsmn::strict> doc;
+ *   if(doc.parse(text) < 0) ...
+ *   for(auto m : doc.root().members())
+ *       use(m.key, m.value.text());
+ *
+ * Error codes and token types are the ones of jsmn.h.
+ */
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "jsmn.h"
+
+namespace jsmn {
+
+/**
+ * Compile time parser options.
+ * Strict       same grammar as JSMN_STRICT
+ * ParentLinks  tokens store the index of their parent
+ * Offset       signed type of offsets, sizes and token indices
+ * Skip         tokens store the number of tokens in their subtree, so
+ *              moving to the next sibling is one addition instead of a walk
+ */
+template <bool Strict, bool ParentLinks = true, class Offset = int, bool Skip = true>
+struct policy
+{
+    static_assert(std::is_integral<Offset>::value && std::is_signed<Offset>::value,
+                  "Offset must be a signed integer type");
+    static constexpr bool strict = Strict;
+    static constexpr bool parent_links = ParentLinks;
+    static constexpr bool skip = Skip;
+    using offset_type = Offset;
+};
+
+using lenient = policy<false>;
+using strict = policy<true>;
+/* documents over 2 GB */
+using large = policy<false, true, std::int64_t>;
+/* same layout as jsmntok_t of the C library */
+using compat = policy<false, true, int, false>;
+
+namespace detail {
+
+template <class O, bool> struct parent_field { O parent; };
+template <class O> struct parent_field<O, false> {};
+template <class O, bool> struct skip_field { O skip; };
+template <class O> struct skip_field<O, false> {};
+
+} /* namespace detail */
+
+/* token of a parser with policy P. fields that P turns off take no space */
+template <class P>
+struct token : detail::parent_field<typename P::offset_type, P::parent_links>,
+               detail::skip_field<typename P::offset_type, P::skip>
+{
+    using offset_type = typename P::offset_type;
+    jsmntype_t type;
+    offset_type start;
+    offset_type end;
+    offset_type size;
+};
+
+namespace detail {
+
+template <bool Strict, class O>
+int lex_primitive(const char* js, O len, O& pos)
+{
+    O p = pos;
+
+    for(;p<len && js[p] != '\0';p++)
+    {
+        switch(js[p])
+        {
+            case ':':
+                if(Strict)
+                    break;
+                goto found;
+            case '\t' : case '\r' : case '\n' : case ' ' :
+            case ','  : case ']'  : case '}' :
+                goto found;
+        }
+        if(js[p] < 32 || js[p] >= 127)
+            return JSMN_ERROR_INVAL;
+    }
+    /* in strict mode a primitive must be followed by a comma/object/array */
+    if(Strict)
+        return JSMN_ERROR_PART;
+
+found:
+    pos = p;
+    return 0;
+}
+
+template <class O>
+int lex_string(const char* js, O len, O& pos)
+{
+    O p = pos + 1;
+    int i;
+
+    for(;p<len && js[p] != '\0';p++)
+    {
+        char c = js[p];
+        if(c == '\"')
+        {
+            pos = p;
+            return 0;
+        }
+        if(c == '\\' && p + 1 < len)
+        {
+            p++;
+            switch(js[p])
+            {
+                case '\"': case '/' : case '\\' : case 'b' :
+                case 'f' : case 'r' : case 'n'  : case 't' :
+                    break;
+                case 'u':
+                    p++;
+                    for(i=0;i<4 && p<len && js[p] != '\0';i++,p++)
+                    {
+                        c = js[p];
+                        if(!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') ||
+                             (c >= 'a' && c <= 'f')))
+                            return JSMN_ERROR_INVAL;
+                    }
+                    p--;
+                    break;
+                default:
+                    return JSMN_ERROR_INVAL;
+            }
+        }
+    }
+    return JSMN_ERROR_PART;
+}
+
+} /* namespace detail */
+
+/**
+ * Parser with policy P. Holds only a stack of open containers, which is
+ * reused between calls.
+ */
+template <class P = lenient>
+class parser
+{
+public:
+    using offset_type = typename P::offset_type;
+    using token_type = token<P>;
+
+    /* parse js into tokens[0, capacity). returns number of tokens or a
+       jsmnerr code, JSMN_ERROR_NOMEM if capacity is too small */
+    offset_type parse(std::string_view js, token_type* tokens, std::size_t capacity)
+    {
+        constexpr std::size_t max = static_cast<std::size_t>(
+            std::numeric_limits<offset_type>::max());
+        const char* s = js.data();
+        const offset_type len = static_cast<offset_type>(js.size());
+        const offset_type cap = static_cast<offset_type>(capacity < max ? capacity : max);
+        offset_type pos, start, n = 0, super = -1;
+        token_type* t;
+        int r;
+        char c;
+
+        /* offsets must fit offset_type */
+        if(js.size() > max)
+            return JSMN_ERROR_INVAL;
+        open_.clear();
+        for(pos=0;pos<len && s[pos] != '\0';pos++)
+        {
+            c = s[pos];
+            switch(c)
+            {
+                case '{': case '[':
+                    if(n == cap)
+                        return JSMN_ERROR_NOMEM;
+                    t = &tokens[n];
+                    t->type = c == '{' ? JSMN_OBJECT : JSMN_ARRAY;
+                    t->start = pos;
+                    t->end = -1;
+                    t->size = 0;
+                    set_parent(t, super);
+                    if(super != -1)
+                        tokens[super].size++;
+                    open_.push_back(n);
+                    super = n++;
+                    break;
+                case '}': case ']':
+                    if(open_.empty() ||
+                       tokens[open_.back()].type != (c == '}' ? JSMN_OBJECT : JSMN_ARRAY))
+                        return JSMN_ERROR_INVAL;
+                    t = &tokens[open_.back()];
+                    t->end = pos + 1;
+                    if constexpr(P::skip)
+                        t->skip = n - open_.back();
+                    open_.pop_back();
+                    super = open_.empty() ? -1 : open_.back();
+                    break;
+                case '\"':
+                    start = pos;
+                    if((r = detail::lex_string(s, len, pos)) < 0)
+                        return r;
+                    if(n == cap)
+                        return JSMN_ERROR_NOMEM;
+                    leaf(&tokens[n], JSMN_STRING, start + 1, pos, super);
+                    if(super != -1)
+                        tokens[super].size++;
+                    n++;
+                    break;
+                case '\t' : case '\r' : case '\n' : case ' ':
+                    break;
+                case ':':
+                    super = n - 1;
+                    break;
+                case ',':
+                    super = open_.empty() ? -1 : open_.back();
+                    break;
+                default:
+                    if constexpr(P::strict)
+                    {
+                        if(!is_primitive_start(c))
+                            return JSMN_ERROR_INVAL;
+                        /* primitives are not keys */
+                        if(super != -1 && (tokens[super].type == JSMN_OBJECT ||
+                           (tokens[super].type == JSMN_STRING && tokens[super].size)))
+                            return JSMN_ERROR_INVAL;
+                    }
+                    start = pos;
+                    if((r = detail::lex_primitive<P::strict>(s, len, pos)) < 0)
+                        return r;
+                    if(n == cap)
+                        return JSMN_ERROR_NOMEM;
+                    leaf(&tokens[n], JSMN_PRIMITIVE, start, pos, super);
+                    if(super != -1)
+                        tokens[super].size++;
+                    n++;
+                    pos--;
+                    break;
+            }
+        }
+        /* unmatched opened object or array */
+        if(!open_.empty())
+            return JSMN_ERROR_PART;
+        return n;
+    }
+
+    /* parse js into out, growing it as needed. out.size() is the token
+       count afterwards */
+    offset_type parse(std::string_view js, std::vector<token_type>& out)
+    {
+        offset_type r;
+
+        if(out.size() < js.size() / 8 + 16)
+            out.resize(js.size() / 8 + 16);
+        while((r = parse(js, out.data(), out.size())) == JSMN_ERROR_NOMEM)
+            out.resize(out.size() * 2);
+        out.resize(r < 0 ? 0 : static_cast<std::size_t>(r));
+        return r;
+    }
+
+private:
+    static constexpr bool is_primitive_start(char c)
+    {
+        return (c >= '0' && c <= '9') || c == '-' || c == 't' || c == 'f' || c == 'n';
+    }
+
+    static void set_parent(token_type* t, offset_type parent)
+    {
+        if constexpr(P::parent_links)
+            t->parent = parent;
+        (void)t;
+        (void)parent;
+    }
+
+    static void leaf(token_type* t, jsmntype_t type, offset_type start,
+                     offset_type end, offset_type parent)
+    {
+        t->type = type;
+        t->start = start;
+        t->end = end;
+        t->size = 0;
+        if constexpr(P::skip)
+            t->skip = 1;
+        set_parent(t, parent);
+    }
+
+    std::vector<offset_type> open_;
+};
+
+/* token following the subtree of t */
+template <class P>
+inline const token<P>* next_sibling(const token<P>* t)
+{
+    if constexpr(P::skip)
+        return t + t->skip;
+    else
+    {
+        typename P::offset_type i, n = t->size;
+        const token<P>* c = t + 1;
+
+        if(t->type == JSMN_OBJECT)
+            n *= 2;
+        else if(t->type != JSMN_ARRAY)
+            return c;
+        for(i=0;i<n;i++)
+            c = next_sibling<P>(c);
+        return c;
+    }
+}
+
+template <class P> class value;
+
+/* one key/value pair of an object */
+template <class P>
+struct member
+{
+    std::string_view key;
+    jsmn::value<P> value;
+};
+
+/**
+ * Read only view of a token and its subtree. A default constructed value
+ * is empty and converts to false; lookups on it return empty values.
+ */
+template <class P>
+class value
+{
+public:
+    using offset_type = typename P::offset_type;
+    using token_type = token<P>;
+
+    value() = default;
+    value(const char* js, const token_type* t) : js_(js), t_(t) {}
+
+    explicit operator bool() const { return t_ != nullptr; }
+    jsmntype_t type() const { return t_ ? t_->type : JSMN_UNDEFINED; }
+    bool is_object() const { return type() == JSMN_OBJECT; }
+    bool is_array() const { return type() == JSMN_ARRAY; }
+    bool is_string() const { return type() == JSMN_STRING; }
+    bool is_primitive() const { return type() == JSMN_PRIMITIVE; }
+    /* number of elements or members */
+    offset_type size() const { return t_ ? t_->size : 0; }
+    /* raw text. strings without quotes and still escaped */
+    std::string_view text() const
+    {
+        if(!t_)
+            return {};
+        return {js_ + t_->start, static_cast<std::size_t>(t_->end - t_->start)};
+    }
+    const token_type* get() const { return t_; }
+
+    template <class T, bool Member>
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = T;
+
+        iterator() = default;
+        iterator(const char* js, const token_type* t, offset_type left)
+            : js_(js), t_(t), left_(left) {}
+
+        T operator*() const
+        {
+            if constexpr(Member)
+                return T{value(js_, t_).text(), value(js_, t_ + 1)};
+            else
+                return T(js_, t_);
+        }
+        iterator& operator++()
+        {
+            t_ = Member ? next_sibling<P>(t_ + 1) : next_sibling<P>(t_);
+            --left_;
+            return *this;
+        }
+        iterator operator++(int) { iterator i = *this; ++*this; return i; }
+        bool operator==(const iterator& o) const { return left_ == o.left_; }
+        bool operator!=(const iterator& o) const { return left_ != o.left_; }
+
+    private:
+        const char* js_ = nullptr;
+        const token_type* t_ = nullptr;
+        offset_type left_ = 0;
+    };
+
+    template <class It>
+    struct range
+    {
+        It first, last;
+        It begin() const { return first; }
+        It end() const { return last; }
+    };
+
+    using element_iterator = iterator<value, false>;
+    using member_iterator = iterator<member<P>, true>;
+
+    /* elements of an array, empty for other types */
+    range<element_iterator> elements() const
+    {
+        offset_type n = is_array() ? t_->size : 0;
+        return {element_iterator(js_, t_ ? t_ + 1 : nullptr, n), element_iterator()};
+    }
+    /* members of an object, empty for other types */
+    range<member_iterator> members() const
+    {
+        offset_type n = is_object() ? t_->size : 0;
+        return {member_iterator(js_, t_ ? t_ + 1 : nullptr, n), member_iterator()};
+    }
+
+    /* value of key in an object. compares the raw key text */
+    value operator[](std::string_view key) const
+    {
+        for(const auto& m : members())
+            if(m.key == key)
+                return m.value;
+        return {};
+    }
+    /* element i of an array */
+    value operator[](std::size_t i) const
+    {
+        if(!is_array() || i >= static_cast<std::size_t>(t_->size))
+            return {};
+        const token_type* t = t_ + 1;
+        for(;i;i--)
+            t = next_sibling<P>(t);
+        return {js_, t};
+    }
+    /* disambiguate literal indices from string_view keys */
+    value operator[](int i) const { return i < 0 ? value() : (*this)[static_cast<std::size_t>(i)]; }
+
+private:
+    const char* js_ = nullptr;
+    const token_type* t_ = nullptr;
+};
+
+/**
+ * Parser, tokens and text in one object. The text is not copied and must
+ * outlive the document.
+ */
+template <class P = lenient>
+class document
+{
+public:
+    using offset_type = typename P::offset_type;
+    using token_type = token<P>;
+
+    offset_type parse(std::string_view js)
+    {
+        js_ = js;
+        return parser_.parse(js, tokens_);
+    }
+    /* empty value if nothing was parsed */
+    value<P> root() const
+    {
+        return tokens_.empty() ? value<P>() : value<P>(js_.data(), tokens_.data());
+    }
+    const std::vector<token_type>& tokens() const { return tokens_; }
+    std::string_view text() const { return js_; }
+
+private:
+    parser<P> parser_;
+    std::vector<token_type> tokens_;
+    std::string_view js_;
+};
+
+/**
+ * Struct binding. Declare the fields of a struct with a jsmn_bind overload
+ * found by argument dependent lookup:
+ *
+ *   struct user { std::string name; int uid; std::vector<std::string> groups; };
+ *   constexpr auto jsmn_bind(user*)
+ *   {
+ *       return jsmn::fields(JSMN_FIELD(user, name), JSMN_FIELD(user, uid),
+ *                           JSMN_FIELD(user, groups));
+ *   }
+ *
+ *   user u;
+ *   int r = jsmn::bind(doc.root(), u);
+ *
+ * A perfect hash of the field names is built at compile time, so a key
+ * costs one hash, one compare and the conversion of its value. Fields may
+ * be bool, arithmetic types, std::string (unescaped), std::string_view
+ * (raw text), std::vector of any of these and bound structs. Unknown keys
+ * are ignored, missing fields keep their value.
+ */
+template <class T, class M>
+struct field
+{
+    std::string_view name;
+    M T::* member;
+};
+
+#define JSMN_FIELD(type, member) \
+    ::jsmn::field<type, decltype(type::member)>{#member, &type::member}
+
+template <class... F>
+struct field_list
+{
+    std::tuple<F...> list;
+};
+
+template <class... F>
+constexpr field_list<F...> fields(F... f)
+{
+    return {std::tuple<F...>(f...)};
+}
+
+namespace detail {
+
+constexpr std::uint32_t hash(std::string_view s, std::uint32_t seed)
+{
+    std::uint32_t h = seed ^ static_cast<std::uint32_t>(s.size()) * 0x9E3779B1u;
+    for(char c : s)
+        h = (h ^ static_cast<unsigned char>(c)) * 0x01000193u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    return h ^ (h >> 13);
+}
+
+/* table size and seed of a perfect hash over names. grows the table
+   until a seed without collisions is found quickly */
+template <std::size_t N>
+constexpr std::pair<unsigned, std::uint32_t> perfect_hash(
+    const std::array<std::string_view, N>& names)
+{
+    unsigned bits = 0;
+    std::uint32_t seed = 1;
+    std::size_t i = 0, j = 0;
+
+    while((std::size_t(1) << bits) < 2 * N)
+        bits++;
+    for(;;bits++)
+    {
+        for(seed=1;seed<=4096;seed++)
+        {
+            std::uint32_t mask = (1u << bits) - 1;
+            bool ok = true;
+            for(i=0;i<N && ok;i++)
+                for(j=0;j<i && ok;j++)
+                    ok = (hash(names[i], seed) & mask) != (hash(names[j], seed) & mask);
+            if(ok)
+                return {bits, seed};
+        }
+    }
+}
+
+template <class T, class = void>
+struct is_bound : std::false_type {};
+template <class T>
+struct is_bound<T, std::void_t<decltype(jsmn_bind(static_cast<T*>(nullptr)))>>
+    : std::true_type {};
+
+template <class T> struct is_vector : std::false_type {};
+template <class T, class A> struct is_vector<std::vector<T, A>> : std::true_type {};
+
+/* append the UTF-8 encoding of the \uXXXX escape at s, with a following
+   low surrogate. returns characters consumed after the backslash or 0 */
+inline std::size_t unescape_unicode(std::string_view s, std::string& out)
+{
+    unsigned long c = 0, lo = 0;
+    std::size_t n = 5;
+
+    if(s.size() < 5 || std::from_chars(s.data() + 1, s.data() + 5, c, 16).ptr != s.data() + 5)
+        return 0;
+    if(c >= 0xD800 && c < 0xDC00 && s.size() >= 11 && s[5] == '\\' && s[6] == 'u' &&
+       std::from_chars(s.data() + 7, s.data() + 11, lo, 16).ptr == s.data() + 11 &&
+       lo >= 0xDC00 && lo < 0xE000)
+    {
+        c = 0x10000 + ((c - 0xD800) << 10) + (lo - 0xDC00);
+        n = 11;
+    }
+    if(c < 0x80)
+        out += static_cast<char>(c);
+    else if(c < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (c >> 6));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+    else if(c < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (c >> 12));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (c >> 18));
+        out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+    return n;
+}
+
+inline bool unescape(std::string_view s, std::string& out)
+{
+    std::size_t i, n;
+
+    out.clear();
+    out.reserve(s.size());
+    for(i=0;i<s.size();i++)
+    {
+        if(s[i] != '\\')
+        {
+            out += s[i];
+            continue;
+        }
+        if(++i == s.size())
+            return false;
+        switch(s[i])
+        {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u':
+                if(!(n = unescape_unicode(s.substr(i), out)))
+                    return false;
+                i += n - 1;
+                break;
+            default: out += s[i]; break;
+        }
+    }
+    return true;
+}
+
+} /* namespace detail */
+
+/* compile time tables of a bound struct */
+template <class T>
+struct binding
+{
+    static constexpr auto list = jsmn_bind(static_cast<T*>(nullptr)).list;
+    static constexpr std::size_t count = std::tuple_size<decltype(list)>::value;
+    static_assert(count > 0 && count < 255, "bind 1 to 254 fields");
+
+    static constexpr std::array<std::string_view, count> names =
+        std::apply([](auto... f) { return std::array<std::string_view, count>{f.name...}; }, list);
+    static constexpr auto hash = detail::perfect_hash(names);
+    static constexpr std::uint32_t mask = (1u << hash.first) - 1;
+
+    /* slot to field index, 255 if empty */
+    static constexpr auto table = []
+    {
+        std::array<std::uint8_t, std::size_t(1) << hash.first> t{};
+        for(auto& s : t)
+            s = 255;
+        for(std::size_t i=0;i<count;i++)
+            t[detail::hash(names[i], hash.second) & mask] = static_cast<std::uint8_t>(i);
+        return t;
+    }();
+
+    /* index of key or -1 */
+    static int find(std::string_view key)
+    {
+        std::uint8_t i = table[detail::hash(key, hash.second) & mask];
+        return i != 255 && names[i] == key ? i : -1;
+    }
+};
+
+template <class P, class T> int bind(value<P> v, T& out);
+
+namespace detail {
+
+template <class P, class T, std::size_t... I>
+int bind_field(value<P> v, T& out, int i, std::index_sequence<I...>)
+{
+    int r = 0;
+    /* expands to a switch on i */
+    ((i == static_cast<int>(I) ?
+      (r = jsmn::bind(v, out.*(std::get<I>(binding<T>::list).member)), true) : false) || ...);
+    return r;
+}
+
+} /* namespace detail */
+
+/* convert v into out. returns 0, JSMN_ERROR_WRONG_TYPE or
+   JSMN_ERROR_NOPARSE for a value that does not fit the type of out */
+template <class P, class T>
+int bind(value<P> v, T& out)
+{
+    std::string_view s = v.text();
+
+    if constexpr(detail::is_bound<T>::value)
+    {
+        int i, r;
+        if(!v.is_object())
+            return JSMN_ERROR_WRONG_TYPE;
+        for(const auto& m : v.members())
+        {
+            if((i = binding<T>::find(m.key)) >= 0 &&
+               (r = detail::bind_field(m.value, out, i,
+                    std::make_index_sequence<binding<T>::count>())) < 0)
+                return r;
+        }
+        return 0;
+    }
+    else if constexpr(detail::is_vector<T>::value)
+    {
+        int r;
+        if(!v.is_array())
+            return JSMN_ERROR_WRONG_TYPE;
+        out.clear();
+        out.reserve(static_cast<std::size_t>(v.size()));
+        for(auto e : v.elements())
+        {
+            out.emplace_back();
+            if((r = jsmn::bind(e, out.back())) < 0)
+                return r;
+        }
+        return 0;
+    }
+    else if constexpr(std::is_same<T, bool>::value)
+    {
+        if(!v.is_primitive() || (s != "true" && s != "false"))
+            return JSMN_ERROR_WRONG_TYPE;
+        out = s[0] == 't';
+        return 0;
+    }
+    else if constexpr(std::is_integral<T>::value)
+    {
+        if(!v.is_primitive())
+            return JSMN_ERROR_WRONG_TYPE;
+        auto res = std::from_chars(s.data(), s.data() + s.size(), out);
+        return res.ec == std::errc() && res.ptr == s.data() + s.size() ? 0 : JSMN_ERROR_NOPARSE;
+    }
+    else if constexpr(std::is_floating_point<T>::value)
+    {
+        char num[64], *end;
+        if(!v.is_primitive())
+            return JSMN_ERROR_WRONG_TYPE;
+        if(s.empty() || s.size() >= sizeof(num))
+            return JSMN_ERROR_NOPARSE;
+        /* strtod needs a terminator, the text has none */
+        s.copy(num, s.size());
+        num[s.size()] = '\0';
+        out = static_cast<T>(std::strtod(num, &end));
+        return end == num + s.size() ? 0 : JSMN_ERROR_NOPARSE;
+    }
+    else if constexpr(std::is_same<T, std::string>::value)
+    {
+        if(!v.is_string())
+            return JSMN_ERROR_WRONG_TYPE;
+        return detail::unescape(s, out) ? 0 : JSMN_ERROR_NOPARSE;
+    }
+    else if constexpr(std::is_same<T, std::string_view>::value)
+    {
+        if(!v.is_string())
+            return JSMN_ERROR_WRONG_TYPE;
+        out = s;
+        return 0;
+    }
+    else
+        static_assert(detail::is_bound<T>::value, "no jsmn_bind for this type");
+}
+
+/* parse js with policy P and bind the root value to out */
+template <class P = lenient, class T>
+int bind(std::string_view js, T& out)
+{
+    document<P> doc;
+    int r;
+
+    if((r = static_cast<int>(doc.parse(js))) < 0)
+        return r;
+    if(r == 0)
+        return JSMN_ERROR_PART;
+    return jsmn::bind(doc.root(), out);
+}
+
+} /* namespace jsmn */
+
+#endif /* __JSMN_HPP_ */
@@ -0,0 +1,271 @@
+#ifndef __JSMN_SAX_H_
+#define __JSMN_SAX_H_
+
+#include "jsmn.h"
+
+/**
+ * Lexer shared by jsmn_parse and the event parsers below.
+ *
+ * jsmn_lex_string expects *pos at the opening quote and leaves it at the
+ * closing quote. jsmn_lex_primitive leaves *pos one past the last character
+ * of the primitive. On error *pos is left unchanged.
+ *
+ * The _from variants continue a token at *pos and return 1 when they run
+ * out of input at len, with *pos at the point to continue from once more
+ * input is available. A NUL terminator still ends the input.
+ */
+static int jsmn_lex_primitive_from(const char *js, size_t len, size_t *pos)
+{
+    size_t p = *pos;
+
+    for (; p < len && js[p] != '\0'; p++) {
+        switch (js[p]) {
+#ifndef JSMN_STRICT
+            /* In strict mode primitive must be followed by "," or "}" or "]" */
+            case ':':
+#endif
+            case '\t' : case '\r' : case '\n' : case ' ' :
+            case ','  : case ']'  : case '}' :
+                goto found;
+        }
+        if (js[p] < 32 || js[p] >= 127) {
+            return JSMN_ERROR_INVAL;
+        }
+    }
+    if (p == len) {
+        *pos = p;
+        return 1;
+    }
+#ifdef JSMN_STRICT
+    /* In strict mode primitive must be followed by a comma/object/array */
+    return JSMN_ERROR_PART;
+#endif
+
+found:
+    *pos = p;
+    return 0;
+}
+
+static int jsmn_lex_primitive(const char *js, size_t len, size_t *pos)
+{
+    size_t p = *pos;
+    int r = jsmn_lex_primitive_from(js, len, &p);
+
+    if (r == 1) {
+#ifdef JSMN_STRICT
+        return JSMN_ERROR_PART;
+#else
+        r = 0;
+#endif
+    }
+    if (r == 0)
+        *pos = p;
+    return r;
+}
+
+static int jsmn_lex_string_from(const char *js, size_t len, size_t *pos)
+{
+    size_t p = *pos, esc;
+
+    for (; p < len && js[p] != '\0'; p++) {
+        char c = js[p];
+
+        /* Quote: end of string */
+        if (c == '\"') {
+            *pos = p;
+            return 0;
+        }
+
+        /* Backslash: Quoted symbol expected */
+        if (c == '\\') {
+            int i;
+            esc = p;
+            if (p + 1 >= len)
+                goto more;
+            p++;
+            switch (js[p]) {
+                /* Allowed escaped symbols */
+                case '\"': case '/' : case '\\' : case 'b' :
+                case 'f' : case 'r' : case 'n'  : case 't' :
+                    break;
+                /* Allows escaped symbol \uXXXX */
+                case 'u':
+                    p++;
+                    for(i = 0; i < 4 && p < len && js[p] != '\0'; i++) {
+                        /* If it isn't a hex character we have an error */
+                        if(!((js[p] >= 48 && js[p] <= 57) || /* 0-9 */
+                                    (js[p] >= 65 && js[p] <= 70) || /* A-F */
+                                    (js[p] >= 97 && js[p] <= 102))) { /* a-f */
+                            return JSMN_ERROR_INVAL;
+                        }
+                        p++;
+                    }
+                    if (i < 4) {
+                        if (p < len)
+                            return JSMN_ERROR_PART;
+                        goto more;
+                    }
+                    p--;
+                    break;
+                /* Unexpected symbol */
+                default:
+                    return JSMN_ERROR_INVAL;
+            }
+        }
+    }
+    if (p < len)
+        return JSMN_ERROR_PART;
+    esc = p;
+
+more:
+    /* continue at an escape cut short, it is read again as a whole */
+    *pos = esc;
+    return 1;
+}
+
+static int jsmn_lex_string(const char *js, size_t len, size_t *pos)
+{
+    size_t p = *pos + 1;
+    int r = jsmn_lex_string_from(js, len, &p);
+
+    if (r == 0)
+        *pos = p;
+    return r == 1 ? JSMN_ERROR_PART : r;
+}
+
+#endif /* __JSMN_SAX_H_ */
+
+/**
+ * Header-only event parser. Define a name and an event handler expression,
+ * then include this file. The handler is expanded inline, so the compiler
+ * can fold it into the lexer loop:
+ *
+ *   #define JSMN_SAX_NAME parse_events
+ *   #define JSMN_SAX_EMIT(user, event, start, end) on_event(user, event, start, end)
+ *   #include "jsmn_sax.h"
+ *
+ * defines
+ *
+ *   static jsmnint_t parse_events(const char *js, size_t len, void *user);
+ *
+ * JSMN_SAX_EMIT returns non-zero to stop parsing with JSMN_ERROR_STOPPED.
+ * Otherwise the return value is the same as jsmn_parse: the number of values
+ * seen, or an error. Memory use is JSMN_MAX_DEPTH levels of nesting, deeper
+ * documents fail with JSMN_ERROR_LIMIT.
+ * The file may be included again with a different name and handler.
+ */
+#if defined(JSMN_SAX_NAME) && defined(JSMN_SAX_EMIT)
+
+static jsmnint_t JSMN_SAX_NAME(const char *js, size_t len, void *user)
+{
+    unsigned char is_object[JSMN_MAX_DEPTH];
+    size_t open[JSMN_MAX_DEPTH];
+    size_t pos, start;
+    int depth = 0;
+    int expect_key = 0;
+#ifdef JSMN_STRICT
+    int need_colon = 0;
+#endif
+    jsmnint_t count = 0;
+    int r;
+
+    if (len > JSMN_MAX_LEN)
+        return JSMN_ERROR_INVAL;
+    for (pos = 0; pos < len && js[pos] != '\0'; pos++) {
+#ifdef JSMN_STRICT
+        /* In strict mode a key must be followed by a colon */
+        if (need_colon) {
+            switch (js[pos]) {
+                case '\t' : case '\r' : case '\n' : case ' ':
+                    break;
+                case ':':
+                    need_colon = 0;
+                    break;
+                default:
+                    return JSMN_ERROR_INVAL;
+            }
+            continue;
+        }
+#endif
+        switch (js[pos]) {
+            case '{': case '[':
+                if (depth == JSMN_MAX_DEPTH)
+                    return JSMN_ERROR_LIMIT;
+                count++;
+                expect_key = js[pos] == '{';
+                is_object[depth] = (unsigned char)expect_key;
+                open[depth++] = pos;
+                if (JSMN_SAX_EMIT(user, expect_key ?
+                            JSMN_EVENT_OBJECT_START : JSMN_EVENT_ARRAY_START,
+                            (jsmnint_t)pos, (jsmnint_t)pos + 1))
+                    return JSMN_ERROR_STOPPED;
+                break;
+            case '}': case ']':
+                if (depth == 0 || is_object[depth - 1] != (js[pos] == '}'))
+                    return JSMN_ERROR_INVAL;
+                depth--;
+                expect_key = 0;
+                if (JSMN_SAX_EMIT(user, is_object[depth] ?
+                            JSMN_EVENT_OBJECT_END : JSMN_EVENT_ARRAY_END,
+                            (jsmnint_t)open[depth], (jsmnint_t)pos + 1))
+                    return JSMN_ERROR_STOPPED;
+                break;
+            case '\"':
+                start = pos;
+                r = jsmn_lex_string(js, len, &pos);
+                if (r < 0) return r;
+                count++;
+                if (JSMN_SAX_EMIT(user, expect_key ?
+                            JSMN_EVENT_KEY : JSMN_EVENT_STRING,
+                            (jsmnint_t)start + 1, (jsmnint_t)pos))
+                    return JSMN_ERROR_STOPPED;
+#ifdef JSMN_STRICT
+                need_colon = expect_key;
+#endif
+                expect_key = 0;
+                break;
+            case '\t' : case '\r' : case '\n' : case ' ': case ':':
+                break;
+            case ',':
+                expect_key = depth > 0 && is_object[depth - 1];
+                break;
+#ifdef JSMN_STRICT
+            /* In strict mode primitives are: numbers and booleans */
+            case '-': case '0': case '1' : case '2': case '3' : case '4':
+            case '5': case '6': case '7' : case '8': case '9':
+            case 't': case 'f': case 'n' :
+                /* And they must not be keys of the object */
+                if (expect_key)
+                    return JSMN_ERROR_INVAL;
+#else
+            /* In non-strict mode every unquoted value is a primitive */
+            default:
+#endif
+                start = pos;
+                r = jsmn_lex_primitive(js, len, &pos);
+                if (r < 0) return r;
+                count++;
+                if (JSMN_SAX_EMIT(user, expect_key ?
+                            JSMN_EVENT_KEY : JSMN_EVENT_PRIMITIVE,
+                            (jsmnint_t)start, (jsmnint_t)pos))
+                    return JSMN_ERROR_STOPPED;
+                expect_key = 0;
+                pos--;
+                break;
+#ifdef JSMN_STRICT
+            /* Unexpected char in strict mode */
+            default:
+                return JSMN_ERROR_INVAL;
+#endif
+        }
+    }
+
+    /* Unmatched opened object or array */
+    if (depth)
+        return JSMN_ERROR_PART;
+    return count;
+}
+
+#undef JSMN_SAX_NAME
+#undef JSMN_SAX_EMIT
+#endif
@@ -401,6 +401,1581 @@ int test_unmatched_brackets(void) {
     return 0;
 }
 
+int test_columns(void) {
+    jsmn_parser p;
+    const char *js;
+    double price[4];
+    int64_t qty[4];
+    jsmnstr_t name[4];
+    unsigned char price_ok[4], qty_ok[4], name_ok[4];
+    double extra[2][4];
+    jsmncolumn_t cols[5];
+    int r, i;
+
+    js = "[{\"name\": \"a\", \"price\": 1.5, \"qty\": 3},"
+        " {\"qty\": -9223372036854775808, \"tags\": [1, {\"price\": 7}]},"
+        " 17,"
+        " {\"price\": \"x\", \"name\": \"bc\", \"qty\": 2.5}]";
+
+    cols[0].key = "price";
+    cols[0].type = JSMN_COLUMN_DOUBLE;
+    cols[0].values = price;
+    cols[0].valid = price_ok;
+    cols[1].key = "qty";
+    cols[1].type = JSMN_COLUMN_INT64;
+    cols[1].values = qty;
+    cols[1].valid = qty_ok;
+    cols[2].key = "name";
+    cols[2].type = JSMN_COLUMN_STRING;
+    cols[2].values = name;
+    cols[2].valid = name_ok;
+
+    jsmn_init(&p);
+    check(jsmn_parse_dynamic_str(&p, js) > 0);
+    r = jsmn_extract_columns(js, p.tokens, cols, 3);
+    check(r == 4);
+
+    check(price_ok[0] && price[0] == 1.5);
+    check(!price_ok[1] && price[1] == 0);
+    check(!price_ok[2] && !price_ok[3]);
+
+    check(qty_ok[0] && qty[0] == 3);
+    check(qty_ok[1] && qty[1] == INT64_MIN);
+    check(!qty_ok[2] && !qty_ok[3]);
+
+    check(name_ok[0] && name[0].end - name[0].start == 1);
+    check(!name_ok[1] && !name_ok[2]);
+    check(name_ok[3] && !strncmp(js + name[3].start, "bc", 2));
+
+    check(jsmn_extract_columns(js, p.tokens + 1, cols, 3) == JSMN_ERROR_WRONG_TYPE);
+    jsmn_destroy(&p);
+
+    /* the last duplicate wins, with the compare loop and the keyset */
+    js = "[{\"price\": 1, \"price\": \"x\", \"qty\": 2, \"qty\": \"x\","
+        " \"name\": \"a\", \"name\": 3}, {\"qty\": \"x\", \"qty\": 4}]";
+    cols[3].key = "u";
+    cols[4].key = "v";
+    for (i = 3; i < 5; i++) {
+        cols[i].type = JSMN_COLUMN_DOUBLE;
+        cols[i].values = extra[i - 3];
+        cols[i].valid = NULL;
+    }
+    jsmn_init(&p);
+    check(jsmn_parse_dynamic_str(&p, js) > 0);
+    for (i = 3; i <= 5; i += 2) {
+        check(jsmn_extract_columns(js, p.tokens, cols, i) == 2);
+        check(!price_ok[0] && price[0] == 0);
+        check(!qty_ok[0] && qty[0] == 0);
+        check(!name_ok[0] && name[0].start == 0 && name[0].end == 0);
+        check(qty_ok[1] && qty[1] == 4);
+    }
+    jsmn_destroy(&p);
+
+    /* the empty column name matches only the empty key */
+    js = "[{\"\": 4, \"a\": 5}, {\"a\": 6}]";
+    cols[0].key = "";
+    cols[0].type = JSMN_COLUMN_INT64;
+    cols[0].values = qty;
+    cols[0].valid = qty_ok;
+    jsmn_init(&p);
+    check(jsmn_parse_dynamic_str(&p, js) > 0);
+    check(jsmn_extract_columns(js, p.tokens, cols, 1) == 2);
+    check(qty_ok[0] && qty[0] == 4);
+    check(!qty_ok[1]);
+    jsmn_destroy(&p);
+    return 0;
+}
+
+typedef struct {
+    const char *js;
+    char out[256];
+    size_t len;
+    int stop_after;
+} event_log;
+
+static int log_event(void *user, jsmnevent_t event, jsmnint_t start, jsmnint_t end) {
+    event_log *log = (event_log *)user;
+    static const char names[] = "?{}[]ksp";
+    log->len += sprintf(log->out + log->len, "%c", names[event]);
+    if (event == JSMN_EVENT_KEY || event == JSMN_EVENT_STRING ||
+            event == JSMN_EVENT_PRIMITIVE)
+        log->len += sprintf(log->out + log->len, "(%.*s)",
+                (int)(end - start), log->js + start);
+    return --log->stop_after == 0;
+}
+
+static int ignore_event(void *user, jsmnevent_t event, jsmnint_t start, jsmnint_t end) {
+    (void)user;
+    (void)event;
+    (void)start;
+    (void)end;
+    return 0;
+}
+
+#define JSMN_SAX_NAME parse_inline_events
+#define JSMN_SAX_EMIT(user, event, start, end) log_event(user, event, start, end)
+#include "../jsmn_sax.h"
+
+int test_events(void) {
+    event_log log;
+    const char *js;
+
+    js = "{\"a\": [1, \"x\", {}], \"b\": {\"c\": null}}";
+    memset(&log, 0, sizeof(log));
+    log.js = js;
+    check(jsmn_parse_events(js, strlen(js), log_event, &log) == 10);
+    check(!strcmp(log.out, "{k(a)[p(1)s(x){}]k(b){k(c)p(null)}}"));
+
+    memset(&log, 0, sizeof(log));
+    log.js = js;
+    check(parse_inline_events(js, strlen(js), &log) == 10);
+    check(!strcmp(log.out, "{k(a)[p(1)s(x){}]k(b){k(c)p(null)}}"));
+
+    memset(&log, 0, sizeof(log));
+    log.js = js;
+    log.stop_after = 3;
+    check(jsmn_parse_events(js, strlen(js), log_event, &log) == JSMN_ERROR_STOPPED);
+    check(!strcmp(log.out, "{k(a)["));
+
+    memset(&log, 0, sizeof(log));
+    log.js = js = "{\"a\": [1}";
+    check(jsmn_parse_events(js, strlen(js), log_event, &log) == JSMN_ERROR_INVAL);
+    memset(&log, 0, sizeof(log));
+    log.js = js = "{\"a\": [1, 2]";
+    check(jsmn_parse_events(js, strlen(js), log_event, &log) == JSMN_ERROR_PART);
+#ifdef JSMN_STRICT
+    memset(&log, 0, sizeof(log));
+    log.js = js = "{1: 2}";
+    check(jsmn_parse_events(js, strlen(js), log_event, &log) == JSMN_ERROR_INVAL);
+    {
+        /* a key without its colon. jsmn_parse only catches the first */
+        static const char *no_colon[] = {"{\"a\" 1}", "{\"a\" \"b\"}", "{\"a\" {}}",
+                                         "{\"a\"}", "{\"a\", \"b\": 1}"};
+        jsmntok_t tokens[8];
+        jsmn_parser p;
+        int i;
+
+        for (i = 0; i < 5; i++) {
+            memset(&log, 0, sizeof(log));
+            log.js = js = no_colon[i];
+            jsmn_init(&p);
+            if (i == 0)
+                check(jsmn_parse(&p, js, strlen(js), tokens, 8) == JSMN_ERROR_INVAL);
+            check(jsmn_parse_events(js, strlen(js), log_event, &log) == JSMN_ERROR_INVAL);
+        }
+        js = "{\"a\" : 1}";
+        check(jsmn_parse_events(js, strlen(js), ignore_event, NULL) == 3);
+    }
+#endif
+
+    /* nesting past JSMN_MAX_DEPTH is a limit, not a lack of memory */
+    {
+        static char deep[JSMN_MAX_DEPTH + 2];
+        memset(deep, '[', JSMN_MAX_DEPTH + 1);
+        check(jsmn_parse_events(deep, JSMN_MAX_DEPTH + 1, ignore_event, NULL) ==
+              JSMN_ERROR_LIMIT);
+        check(jsmn_parse_events(deep, JSMN_MAX_DEPTH, ignore_event, NULL) == JSMN_ERROR_PART);
+    }
+    return 0;
+}
+
+typedef struct {
+    const char *js;
+    size_t pos;
+    size_t chunk;
+} chunk_source;
+
+static int read_chunk(void *user, char *buf, size_t size) {
+    chunk_source *src = (chunk_source *)user;
+    size_t n = strlen(src->js + src->pos);
+    if (n > src->chunk) n = src->chunk;
+    if (n > size) n = size;
+    memcpy(buf, src->js + src->pos, n);
+    src->pos += n;
+    return (int)n;
+}
+
+static int pull_events(jsmn_reader *r, event_log *log) {
+    jsmn_event ev;
+    int rc;
+    while ((rc = jsmn_next(r, &ev)) > 0) {
+        if (ev.text && strncmp(ev.text, log->js + ev.start, ev.end - ev.start))
+            return JSMN_ERROR_INVAL;
+        log_event(log, ev.type, (int)ev.start, (int)ev.end);
+    }
+    return rc;
+}
+
+int test_reader(void) {
+    jsmn_reader r;
+    jsmn_event ev;
+    chunk_source src;
+    event_log log;
+    const char *js;
+
+    js = "{\"long key\": [1234567, \"x\", {}], \"b\": {\"c\": null}}";
+    src.js = js;
+    src.pos = 0;
+    src.chunk = 3;
+    memset(&log, 0, sizeof(log));
+    log.js = js;
+    check(jsmn_reader_init(&r, read_chunk, &src, NULL, 4) == 0);
+    check(pull_events(&r, &log) == 0);
+    check(!strcmp(log.out, "{k(long key)[p(1234567)s(x){}]k(b){k(c)p(null)}}"));
+    jsmn_reader_destroy(&r);
+
+    /* skip the first member and the rest of the inner object */
+    src.pos = 0;
+    memset(&log, 0, sizeof(log));
+    log.js = js;
+    check(jsmn_reader_init(&r, read_chunk, &src, NULL, 4) == 0);
+    check(jsmn_next(&r, &ev) == 1 && ev.type == JSMN_EVENT_OBJECT_START);
+    check(jsmn_skip_value(&r) == 1);
+    check(jsmn_next(&r, &ev) == 1 && ev.type == JSMN_EVENT_KEY);
+    check(ev.start == 34 && ev.end == 35);
+    check(jsmn_next(&r, &ev) == 1 && ev.type == JSMN_EVENT_OBJECT_START);
+    check(ev.depth == 1);
+    check(jsmn_skip_value(&r) == 1);
+    check(jsmn_skip_value(&r) == 0);
+    check(jsmn_next(&r, &ev) == 1 && ev.type == JSMN_EVENT_OBJECT_END);
+    check(ev.start == 38 && ev.end == 49);
+    check(jsmn_next(&r, &ev) == 1 && ev.type == JSMN_EVENT_OBJECT_END);
+    check(jsmn_next(&r, &ev) == 0);
+    jsmn_reader_destroy(&r);
+
+    /* a fixed window that cannot hold a string */
+    src.pos = 0;
+    {
+        char small[4];
+        check(jsmn_reader_init(&r, read_chunk, &src, small, sizeof(small)) == 0);
+        check(jsmn_next(&r, &ev) == 1);
+        check(jsmn_next(&r, &ev) == JSMN_ERROR_NOMEM);
+    }
+
+    js = "[1, [2, \"]\"], 3]";
+    memset(&log, 0, sizeof(log));
+    log.js = js;
+    jsmn_reader_init_buffer(&r, js, strlen(js));
+    check(jsmn_next(&r, &ev) == 1);
+    check(jsmn_skip_value(&r) == 1);
+    check(jsmn_skip_value(&r) == 1);
+    check(pull_events(&r, &log) == 0);
+    check(!strcmp(log.out, "p(3)]"));
+
+    js = "[1, 2";
+    jsmn_reader_init_buffer(&r, js, strlen(js));
+    memset(&log, 0, sizeof(log));
+    log.js = js;
+    check(pull_events(&r, &log) == JSMN_ERROR_PART);
+    return 0;
+}
+
+int test_filter(void) {
+    jsmn_filter f;
+    const char *js;
+    size_t pos = 0, start, end;
+
+    js = "{\"level\": \"error\", \"latency\": 900, \"tags\": [\"a\", \"b\"]}\n"
+        "{\"level\": \"info\", \"latency\": 900}\n"
+        "\n"
+        "{\"latency\": 501, \"level\": \"error\", \"meta\": {\"odd key\": 1}}\r\n"
+        "{\"level\": \"error\", \"latency\": 12}\n"
+        "{\"level\": \"error\"}\n"
+        "{\"level\": \"error\", \"latency\": [broken\n";
+
+    jsmn_filter_init(&f);
+    check(jsmn_filter_compile(&f, "level == \"error\" && latency > 500") == 0);
+    check(f.num_clauses == 2);
+    check(jsmn_filter_next(&f, js, strlen(js), &pos, &start, &end) == 1);
+    check(start == 0 && js[end] == '\n' && js[end - 1] == '}');
+    check(jsmn_filter_next(&f, js, strlen(js), &pos, &start, &end) == 1);
+    check(!strncmp(js + start, "{\"latency\": 501", 15) && js[end] == '\r');
+    check(jsmn_filter_next(&f, js, strlen(js), &pos, &start, &end) == 0);
+    check(pos == strlen(js));
+    jsmn_filter_destroy(&f);
+
+    jsmn_filter_init(&f);
+    check(jsmn_filter_compile(&f, "tags[1] == \"b\"") == 0);
+    check(jsmn_filter_match(&f, js, strchr(js, '\n') - js));
+    jsmn_filter_destroy(&f);
+
+    jsmn_filter_init(&f);
+    check(jsmn_filter_compile(&f, "meta.\"odd key\" >= 1 && meta") == 0);
+    check(f.clauses[0].depth == 2 && f.clauses[1].depth == 1);
+    check(f.clauses[1].op == JSMN_FILTER_EXISTS);
+    check(jsmn_filter_match(&f, "{\"meta\": {\"odd key\": 1.5}}", 27));
+    check(!jsmn_filter_match(&f, "{\"meta\": {\"odd key\": 0.5}}", 27));
+    check(!jsmn_filter_match(&f, "{\"meta\": {\"odd\": 1.5}}", 23));
+    jsmn_filter_destroy(&f);
+
+    jsmn_filter_init(&f);
+    check(jsmn_filter_add(&f, JSMN_FILTER_NE, "null", "oao", "a", 1, "b") == 0);
+    check(jsmn_filter_add(&f, JSMN_FILTER_EQ, "1", "x") == JSMN_ERROR_INVAL);
+    check(f.num_clauses == 1);
+    js = "{\"a\": [{\"b\": null}, {\"b\": true}]}";
+    check(jsmn_filter_match(&f, js, strlen(js)));
+    js = "{\"a\": [{\"b\": true}, {\"b\": null}]}";
+    check(!jsmn_filter_match(&f, js, strlen(js)));
+    jsmn_filter_destroy(&f);
+
+    jsmn_filter_init(&f);
+    check(jsmn_filter_compile(&f, "a ==") == JSMN_ERROR_INVAL);
+    check(jsmn_filter_compile(&f, "a == 1 || b") == JSMN_ERROR_INVAL);
+    jsmn_filter_destroy(&f);
+
+    /* a match is only reported for a valid record */
+    jsmn_filter_init(&f);
+    check(jsmn_filter_compile(&f, "level == \"error\"") == 0);
+    js = "{\"level\": \"error\", garbage ]]]";
+    check(!jsmn_filter_match(&f, js, strlen(js)));
+    js = "{\"level\": \"error\", \"x\": [1, {\"y\": 2}]}";
+    check(jsmn_filter_match(&f, js, strlen(js)));
+    jsmn_filter_destroy(&f);
+    return 0;
+}
+
+int test_writer(void) {
+    jsmn_writer w;
+    char small[8];
+    const char *s = "a long string with a \"quote\" and \\ and \n\x01 ctrl";
+    int i;
+
+    check(jsmn_writer_init(&w, NULL, 4) == 0);
+    jsmn_write_object_begin(&w);
+    jsmn_write_key(&w, "s", 1);
+    jsmn_write_string(&w, s, strlen(s));
+    jsmn_write_key(&w, "n", 1);
+    jsmn_write_array_begin(&w);
+    jsmn_write_int64(&w, 0);
+    jsmn_write_int64(&w, -42);
+    jsmn_write_int64(&w, INT64_MIN);
+    jsmn_write_double(&w, 0.1);
+    jsmn_write_double(&w, 3.0);
+    jsmn_write_double(&w, -0.0);
+    jsmn_write_double(&w, 1e300);
+    jsmn_write_double(&w, 0.0 / 0.0);
+    jsmn_write_array_end(&w);
+    jsmn_write_key(&w, "e", 1);
+    jsmn_write_object_begin(&w);
+    jsmn_write_object_end(&w);
+    jsmn_write_key(&w, "b", 1);
+    jsmn_write_bool(&w, 1);
+    check(jsmn_write_object_end(&w) == 0);
+    check(w.len == strlen("{\"s\":\"a long string with a \\\"quote\\\" and \\\\ and "
+                "\\n\\u0001 ctrl\",\"n\":[0,-42,-9223372036854775808,0.1,3,-0,"
+                "1e+300,null],\"e\":{},\"b\":true}"));
+    check(!strncmp(w.buf, "{\"s\":\"a long string with a \\\"quote\\\" and \\\\ and "
+                "\\n\\u0001 ctrl\",\"n\":[0,-42,-9223372036854775808,0.1,3,-0,"
+                "1e+300,null],\"e\":{},\"b\":true}", w.len));
+    check(jsmn_write_object_end(&w) == JSMN_ERROR_INVAL);
+    check(jsmn_write_null(&w) == JSMN_ERROR_INVAL);
+    jsmn_writer_reset(&w);
+    check(jsmn_write_double(&w, 123.456) == 0);
+    check(w.len == 7 && !strncmp(w.buf, "123.456", 7));
+
+    /* subnormals, extremes and powers of ten */
+    for (i = 0; i < 8; i++) {
+        static const char *const text[] = {"5e-324", "1e-323",
+            "2.225073858507201e-308", "2.2250738585072014e-308",
+            "1.7976931348623157e+308", "-0.3", "1e+23", "9.5e-5"};
+        jsmn_writer_reset(&w);
+        check(jsmn_write_double(&w, strtod(text[i], NULL)) == 0);
+        check(w.len == strlen(text[i]) && !strncmp(w.buf, text[i], w.len));
+    }
+    for (i = -307; i <= 308; i++) {
+        char text[32];
+        if (i < -4 || i >= 17)
+            sprintf(text, "1e%c%d", i < 0 ? '-' : '+', i < 0 ? -i : i);
+        else if (i < 0)
+            sprintf(text, "0.%.*s1", -i - 1, "000");
+        else
+            sprintf(text, "1%.*s", i, "0000000000000000");
+        jsmn_writer_reset(&w);
+        check(jsmn_write_double(&w, strtod(text, NULL)) == 0);
+        check(w.len == strlen(text) && !strncmp(w.buf, text, w.len));
+    }
+    jsmn_writer_destroy(&w);
+
+    check(jsmn_writer_init(&w, small, sizeof(small)) == 0);
+    check(jsmn_write_array_begin(&w) == 0);
+    check(jsmn_write_string(&w, "abc", 3) == 0);
+    check(jsmn_write_string(&w, "abc", 3) == JSMN_ERROR_NOMEM);
+    check(jsmn_write_array_end(&w) == JSMN_ERROR_NOMEM);
+    check(w.len == 6);
+    jsmn_writer_destroy(&w);
+
+    /* an escaped key with indentation in a caller buffer one byte short
+       of its ": " suffix, then one that fits */
+    for (i = 15; i <= 16; i++) {
+        char *tight = malloc(i);
+        check(jsmn_writer_init(&w, tight, i) == 0);
+        w.indent = 2;
+        check(jsmn_write_object_begin(&w) == 0);
+        check(jsmn_write_key(&w, "ab\x01", 3) == (i == 15 ? JSMN_ERROR_NOMEM : 0));
+        check(i == 15 || (w.len == 16 && !strncmp(tight, "{\n  \"ab\\u0001\": ", 16)));
+        jsmn_writer_destroy(&w);
+        free(tight);
+    }
+    return 0;
+}
+
+int test_transcode(void) {
+    jsmn_parser p;
+    jsmn_writer w;
+    const char *js, *pretty, *compact;
+
+    js = " { \"a\" : [ 1 , \"x y\\\" \" , { } , [ ] ] ,\n\t\"b\" : { \"c\" : null } } ";
+    compact = "{\"a\":[1,\"x y\\\" \",{},[]],\"b\":{\"c\":null}}";
+    pretty = "{\n  \"a\": [\n    1,\n    \"x y\\\" \",\n    {},\n    []\n  ],\n"
+        "  \"b\": {\n    \"c\": null\n  }\n}";
+
+    jsmn_init(&p);
+    check(jsmn_parse_dynamic_str(&p, js) == 11);
+    check(jsmn_writer_init(&w, NULL, 0) == 0);
+    check(jsmn_transcode(js, p.tokens, &w) == 11);
+    check(w.len == strlen(compact) && !strncmp(w.buf, compact, w.len));
+
+    jsmn_writer_reset(&w);
+    w.indent = 2;
+    check(jsmn_transcode(js, p.tokens, &w) == 11);
+    check(w.len == strlen(pretty) && !strncmp(w.buf, pretty, w.len));
+
+    jsmn_writer_reset(&w);
+    check(jsmn_transcode_text(js, strlen(js), &w) == 11);
+    check(w.len == strlen(pretty) && !strncmp(w.buf, pretty, w.len));
+
+    jsmn_writer_reset(&w);
+    w.indent = 0;
+    check(jsmn_transcode_text(js, strlen(js), &w) == 11);
+    check(w.len == strlen(compact) && !strncmp(w.buf, compact, w.len));
+
+    /* nested inside other writer output */
+    jsmn_writer_reset(&w);
+    jsmn_write_array_begin(&w);
+    jsmn_write_int64(&w, 0);
+    check(jsmn_minify_text(js, strlen(js), &w) == 0);
+    check(jsmn_write_array_end(&w) == 0);
+    check(w.len == strlen(compact) + 4 && !strncmp(w.buf, "[0,{", 4));
+    check(!strncmp(w.buf + 3, compact, strlen(compact)));
+
+    jsmn_writer_reset(&w);
+    js = "[\"a long string with  spaces and a \\\"quote\\\" in it\",                   "
+        "\"                 \",   1234567890123456789   ]";
+    check(jsmn_minify_text(js, strlen(js), &w) == 0);
+    compact = "[\"a long string with  spaces and a \\\"quote\\\" in it\","
+        "\"                 \",1234567890123456789]";
+    check(w.len == strlen(compact) && !strncmp(w.buf, compact, w.len));
+
+    jsmn_writer_destroy(&w);
+    jsmn_destroy(&p);
+    return 0;
+}
+
+static int patch_result(jsmn_patch *patch, const char *expected) {
+    jsmn_writer w;
+    jsmn_iovec iov[32];
+    char joined[256];
+    size_t len = 0;
+    int i, n, ok;
+
+    if (jsmn_writer_init(&w, NULL, 0) || jsmn_patch_write(patch, &w))
+        return 0;
+    ok = w.len == strlen(expected) && !strncmp(w.buf, expected, w.len) &&
+        jsmn_patch_size(patch) == w.len;
+    if (!ok)
+        printf("patched '%.*s'\n", (int)w.len, w.buf);
+    jsmn_writer_destroy(&w);
+
+    n = jsmn_patch_iovec(patch, iov, 32);
+    for (i = 0; i < n; i++) {
+        memcpy(joined + len, iov[i].iov_base, iov[i].iov_len);
+        len += iov[i].iov_len;
+    }
+    return ok && n > 0 && len == strlen(expected) && !strncmp(joined, expected, len);
+}
+
+int test_patch(void) {
+    /* document, removes "-pointer" and adds "value/pointer", result */
+    static const char *const mixed[][6] = {
+        {"{\"a\":1}", "-/a", "2/b", "{\"b\":2}"},
+        {"[1]", "-/0", "9/-", "[9]"},
+        {"{\"a\":1,\"b\":2,\"c\":3}", "-/b", "-/c", "{\"a\":1}"},
+        {"{\"a\":1,\"b\":2,\"c\":3}", "-/c", "-/a", "{\"b\":2}"},
+        {"[1,2]", "-/0", "-/1", "[]"},
+        {"[1,2]", "-/1", "-/0", "7/-", "[7]"},
+        {"[ 1, 2, 3 ]", "-/1", "-/2", "5/1", "[ 1, 5 ]"},
+        {"[1, 2, 3]", "-/0", "-/1", "0/0", "[0, 3]"},
+        {"[\n  1,\n  2,\n  3\n]", "-/0", "-/2", "[\n  2\n]"},
+        {"{\"a\": {}, \"b\": []}", "1/a/x", "-/b", "2/a/y", "{\"a\": {\"x\":1,\"y\":2}}"},
+        {"[1]", "8/0", "9/0", "-/0", "[8,9]"},
+        {"[]", "8/0", "9/-", "[8,9]"},
+    };
+    jsmn_parser p;
+    jsmn_patch patch;
+    jsmn_iovec iov[1];
+    const char *js;
+    int i, j;
+
+    js = "{\"a\": 1, \"b\": [1, 2, 3], \"c/d\": {\"e\": \"x\"}, \"f\": {}}";
+    jsmn_init(&p);
+    check(jsmn_parse_dynamic_str(&p, js) > 0);
+
+    check(jsmn_pointer(js, p.tokens, "") == p.tokens);
+    check(jsmn_pointer(js, p.tokens, "/b/2") == p.tokens + 7);
+    check(jsmn_pointer(js, p.tokens, "/c~1d/e") == p.tokens + 11);
+    check(jsmn_pointer(js, p.tokens, "/b/3") == NULL);
+    check(jsmn_pointer(js, p.tokens, "/b/01") == NULL);
+    check(jsmn_pointer(js, p.tokens, "/x") == NULL);
+
+    check(jsmn_patch_init(&patch, js, strlen(js), p.tokens) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REPLACE, "/a", "true", 4) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REMOVE, "/b/1", NULL, 0) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/b/0", "0", 1) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/b/-", "4", 1) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REPLACE, "/c~1d/e", "\"y\"", 3) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/f/new~0\"", "null", 4) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/g", "[]", 2) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REPLACE, "/x", "1", 1) == JSMN_ERROR_NOFOUND);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/b/9", "1", 1) == JSMN_ERROR_NOFOUND);
+    check(patch_result(&patch, "{\"a\": true, \"b\": [0,1, 3,4], \"c/d\": {\"e\": \"y\"}, "
+                "\"f\": {\"new~\\\"\":null},\"g\":[]}"));
+    check(jsmn_patch_iovec(&patch, iov, 1) == JSMN_ERROR_NOMEM);
+    jsmn_patch_destroy(&patch);
+
+    check(jsmn_patch_init(&patch, js, strlen(js), p.tokens) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REMOVE, "/f", NULL, 0) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REMOVE, "/a", NULL, 0) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REMOVE, "/c~1d/e", NULL, 0) == 0);
+    check(patch_result(&patch, "{\"b\": [1, 2, 3], \"c/d\": {}}"));
+    /* overlapping edits are rejected when added and leave the patch as is */
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REPLACE, "/c~1d", "0", 1) == JSMN_ERROR_INVAL);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/a", "0", 1) == JSMN_ERROR_INVAL);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/f/x", "0", 1) == JSMN_ERROR_INVAL);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/h", "0", 1) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/h", "1", 1) == JSMN_ERROR_INVAL);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/h2", "2", 1) == 0);
+    check(jsmn_patch_size(&patch) == strlen("{\"b\": [1, 2, 3], \"c/d\": {}, \"h\":0,\"h2\":2}"));
+    check(patch_result(&patch, "{\"b\": [1, 2, 3], \"c/d\": {}, \"h\":0,\"h2\":2}"));
+    jsmn_patch_destroy(&patch);
+
+    check(jsmn_patch_init(&patch, js, strlen(js), p.tokens) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REPLACE, "/b/1", "5", 1) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REPLACE, "/b/1", "6", 1) == JSMN_ERROR_INVAL);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REMOVE, "/b", NULL, 0) == JSMN_ERROR_INVAL);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/b/1", "4", 1) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, "/b/2", "7", 1) == 0);
+    check(patch_result(&patch, "{\"a\": 1, \"b\": [1, 4,5, 7,3], \"c/d\": {\"e\": \"x\"}, \"f\": {}}"));
+    jsmn_patch_destroy(&patch);
+
+    check(jsmn_patch_init(&patch, js, strlen(js), p.tokens) == 0);
+    check(jsmn_patch_op(&patch, JSMN_PATCH_REPLACE, "", "[]", 2) == 0);
+    check(patch_result(&patch, "[]"));
+    jsmn_patch_destroy(&patch);
+    jsmn_destroy(&p);
+
+    /* commas stay valid whatever removes and adds are combined */
+    for (i = 0; i < (int)(sizeof(mixed) / sizeof(mixed[0])); i++) {
+        js = mixed[i][0];
+        jsmn_init(&p);
+        check(jsmn_parse_dynamic_str(&p, js) > 0);
+        check(jsmn_patch_init(&patch, js, strlen(js), p.tokens) == 0);
+        for (j = 1; mixed[i][j + 1]; j++) {
+            if (mixed[i][j][0] == '-')
+                check(jsmn_patch_op(&patch, JSMN_PATCH_REMOVE, mixed[i][j] + 1,
+                            NULL, 0) == 0);
+            else
+                check(jsmn_patch_op(&patch, JSMN_PATCH_ADD, strchr(mixed[i][j], '/'),
+                            mixed[i][j], strchr(mixed[i][j], '/') - mixed[i][j]) == 0);
+        }
+        check(patch_result(&patch, mixed[i][j]));
+        jsmn_patch_destroy(&patch);
+        jsmn_destroy(&p);
+    }
+    return 0;
+}
+
+static int reparse_matches(jsmn_parser *p, const char *js) {
+    jsmn_parser full;
+    int i, r, ok;
+
+    jsmn_init(&full);
+    r = jsmn_parse_dynamic_str(&full, js);
+    ok = r == (int)p->toknext;
+    for (i = 0; ok && i < r; i++) {
+        ok = full.tokens[i].type == p->tokens[i].type &&
+            full.tokens[i].start == p->tokens[i].start &&
+            full.tokens[i].end == p->tokens[i].end &&
+            full.tokens[i].size == p->tokens[i].size &&
+            full.tokens[i].parent == p->tokens[i].parent;
+        if (!ok)
+            printf("token %d differs\n", i);
+    }
+    jsmn_destroy(&full);
+    return ok;
+}
+
+static void edit(char *js, size_t offset, size_t removed, const char *text) {
+    memmove(js + offset + strlen(text), js + offset + removed,
+            strlen(js + offset + removed) + 1);
+    memcpy(js + offset, text, strlen(text));
+}
+
+int test_reparse(void) {
+#ifdef JSMN_PARENT_LINKS
+    jsmn_parser p;
+    jsmntok_t tokens[32];
+    char js[128];
+
+    strcpy(js, "{\"a\": [1, {\"b\": 2}], \"c\": {\"d\": [3]}, \"e\": 4}");
+    jsmn_init(&p);
+    check(jsmn_parse_dynamic_str(&p, js) == 14);
+
+    edit(js, 16, 1, "[5, 6]");
+    check(!strcmp(js, "{\"a\": [1, {\"b\": [5, 6]}], \"c\": {\"d\": [3]}, \"e\": 4}"));
+    check(jsmn_reparse(&p, js, strlen(js), 16, 1, 6) == 16);
+    check(reparse_matches(&p, js));
+
+    edit(js, 38, 1, "");
+    check(!strcmp(js, "{\"a\": [1, {\"b\": [5, 6]}], \"c\": {\"d\": []}, \"e\": 4}"));
+    check(jsmn_reparse(&p, js, strlen(js), 38, 1, 0) == 15);
+    check(reparse_matches(&p, js));
+
+    /* unbalanced edit is rejected and leaves the tokens alone */
+    edit(js, 38, 0, "{");
+    check(jsmn_reparse(&p, js, strlen(js), 38, 0, 1) < 0);
+    edit(js, 38, 1, "");
+    check(reparse_matches(&p, js));
+    jsmn_destroy(&p);
+
+    /* caller owned tokens that are too few */
+    strcpy(js, "[1, [2]]");
+    jsmn_init(&p);
+    check(jsmn_parse(&p, js, strlen(js), tokens, 4) == 4);
+    edit(js, 6, 0, ", 3, 4");
+    check(jsmn_reparse(&p, js, strlen(js), 6, 0, 6) == JSMN_ERROR_NOMEM);
+    p.num_tokens = 32;
+    check(jsmn_reparse(&p, js, strlen(js), 6, 0, 6) == 6);
+    check(reparse_matches(&p, js));
+
+    /* top level edit parses everything */
+    strcpy(js, "\"7\"");
+    jsmn_init(&p);
+    check(jsmn_parse(&p, js, strlen(js), tokens, 32) == 1);
+    edit(js, 0, 3, "[7]");
+    check(jsmn_reparse(&p, js, strlen(js), 0, 3, 3) == 2);
+    check(reparse_matches(&p, js));
+#endif
+    return 0;
+}
+
+int test_cache(void) {
+    const char *path = "test_cache.tmp";
+    char js[] = "{\"a\": [1, 2, {\"b\": null}], \"c\": \"d\"}";
+    jsmntok_t tokens[16];
+    jsmn_parser p;
+    jsmn_cache cache;
+    int r, i;
+
+    jsmn_init(&p);
+    r = jsmn_parse(&p, js, strlen(js), tokens, 16);
+    check(r == 10);
+    check(jsmn_cache_save(path, js, strlen(js), tokens, r) == 0);
+
+    check(jsmn_cache_load(&cache, path, js, strlen(js)) == 0);
+    check(cache.num_tokens == 10);
+    check(!memcmp(cache.tokens, tokens, sizeof(jsmntok_t) * 10));
+    check(jsmn_lookup(js, cache.tokens, "c") == &cache.tokens[9]);
+    jsmn_cache_close(&cache);
+
+    /* same length, different text */
+    js[7] = '3';
+    check(jsmn_cache_load(&cache, path, js, strlen(js)) == JSMN_ERROR_INVAL);
+    check(cache.tokens == NULL);
+    js[7] = '1';
+    check(jsmn_cache_load(&cache, path, js, strlen(js) - 1) == JSMN_ERROR_INVAL);
+
+    /* tokens that do not describe the text are rejected */
+    for (i = 0; i < 6; i++) {
+        jsmntok_t bad[10];
+        memcpy(bad, tokens, sizeof(bad));
+        switch (i) {
+            case 0: bad[9].end = (jsmnint_t)strlen(js) + 1; break;
+            case 1: bad[4].start = bad[4].end + 1; break;
+            case 2: bad[2].size = 4; break;
+            case 3: bad[1].size = 0; break;
+            case 4: bad[9].type = JSMN_UNDEFINED; break;
+#ifdef JSMN_PARENT_LINKS
+            case 5: bad[9].parent = 10; break;
+#else
+            case 5: bad[0].size = 3; break;
+#endif
+        }
+        check(jsmn_cache_save(path, js, strlen(js), bad, 10) == 0);
+        check(jsmn_cache_load(&cache, path, js, strlen(js)) == JSMN_ERROR_INVAL);
+    }
+
+    /* no single bit flip of the file loads */
+    check(jsmn_cache_save(path, js, strlen(js), tokens, r) == 0);
+    {
+        unsigned char file[512];
+        size_t n, bit;
+        FILE *f;
+        int loaded = 0;
+
+        check((f = fopen(path, "rb")) != NULL);
+        n = fread(file, 1, sizeof(file), f);
+        fclose(f);
+        check(n > 10 * sizeof(jsmntok_t) && n < sizeof(file));
+        for (bit = 0; bit < n * 8; bit++) {
+            file[bit / 8] ^= (unsigned char)(1 << bit % 8);
+            check((f = fopen(path, "wb")) != NULL);
+            check(fwrite(file, 1, n, f) == n);
+            fclose(f);
+            if (jsmn_cache_load(&cache, path, js, strlen(js)) == 0) {
+                loaded++;
+                jsmn_cache_close(&cache);
+            }
+            file[bit / 8] ^= (unsigned char)(1 << bit % 8);
+        }
+        check(loaded == 0);
+    }
+
+    /* hash is sensitive to every byte and the seed */
+    check(jsmn_hash(js, 33, 0) != jsmn_hash(js, 32, 0));
+    check(jsmn_hash(js, strlen(js), 0) != jsmn_hash(js, strlen(js), 1));
+
+    remove(path);
+    check(jsmn_cache_load(&cache, path, js, strlen(js)) == JSMN_ERROR_IO);
+    return 0;
+}
+
+int test_parse_file(void) {
+    const char *path = "test_parse_file.tmp";
+    const char *js = "{\"a\": [1, true], \"b\": 2}";
+    jsmn_parser p;
+    FILE *f;
+#ifndef JSMN_STRICT
+    double d;
+    int i;
+#endif
+
+    f = fopen(path, "wb");
+    check(f != NULL);
+    fputs(js, f);
+    fclose(f);
+
+    jsmn_init(&p);
+    check(jsmn_parse_file(&p, path) == 7);
+    check(p.map_len == strlen(js));
+    check(!memcmp(p.map, js, p.map_len));
+    check(jsmn_lookup(p.map, p.tokens, "b") == &p.tokens[6]);
+    check(p.tokens[0].end == (int)p.map_len);
+
+    /* the same parser on the next file */
+    f = fopen(path, "wb");
+    check(f != NULL);
+    fputs("[1,2,3]", f);
+    fclose(f);
+    check(jsmn_parse_file(&p, path) == 4);
+    check(p.map_len == 7 && p.tokens[0].type == JSMN_ARRAY && p.tokens[0].size == 3);
+    f = fopen(path, "wb");
+    check(f != NULL);
+    fputs("{\"k\":[true,false]}", f);
+    fclose(f);
+    check(jsmn_parse_file(&p, path) == 5);
+    check(p.tokens[0].type == JSMN_OBJECT && p.tokens[0].size == 1);
+    check(p.tokens[2].type == JSMN_ARRAY && p.tokens[2].size == 2);
+    jsmn_destroy(&p);
+    check(p.map == NULL);
+    remove(path);
+
+    jsmn_init(&p);
+    check(jsmn_parse_file(&p, path) == JSMN_ERROR_IO);
+    jsmn_destroy(&p);
+
+#ifndef JSMN_STRICT
+    /* a number that ends the last page of the mapping */
+    f = fopen(path, "wb");
+    check(f != NULL);
+    for (i = 0; i < 4096 - 3; i++)
+        fputc(' ', f);
+    fputs("1.5", f);
+    fclose(f);
+    jsmn_init(&p);
+    check(jsmn_parse_file(&p, path) == 1);
+    check(jsmn_try_parse_double(p.map, p.tokens, &d) && d == 1.5);
+    jsmn_destroy(&p);
+    remove(path);
+#endif
+    return 0;
+}
+
+int test_offset_width(void) {
+    const char *js = "{\"a\": [1, 2, {\"b\": \"c\"}]}";
+    jsmntok_t tokens[16];
+    jsmn_parser p;
+    jsmntok_t *t;
+
+#ifdef JSMN_LARGE
+    check(sizeof(tokens[0].start) == 8 && sizeof(p.pos) == 8);
+#else
+    check(sizeof(tokens[0].start) == sizeof(int));
+#endif
+    jsmn_init(&p);
+    check(jsmn_parse(&p, js, strlen(js), tokens, 16) == 8);
+    check(p.pos == strlen(js));
+    t = jsmn_find(js, tokens, "oao", "a", 2, "b");
+    check(t != NULL && t->type == JSMN_STRING);
+    check(t->parent == 6 && tokens[t->parent].parent == 5);
+    check(t == jsmn_pointer(js, tokens, "/a/2/b"));
+
+    /* longer input than the offsets can address is rejected unread */
+    if ((size_t)-1 > JSMN_MAX_LEN) {
+        jsmn_init(&p);
+        check(jsmn_parse(&p, js, JSMN_MAX_LEN + 1, tokens, 16) == JSMN_ERROR_INVAL);
+        check(jsmn_parse_events(js, JSMN_MAX_LEN + 1, NULL, NULL) == JSMN_ERROR_INVAL);
+    }
+    return 0;
+}
+
+int test_seek_index(void) {
+    const char *path = "test_seek_index.tmp";
+    char js[8192];
+    size_t len = 0, start, end;
+    jsmn_seek_index idx, loaded;
+    jsmn_checkpoint cp;
+    jsmn_reader r;
+    chunk_source src;
+    jsmn_event ev;
+    jsmn_parser p;
+    jsmntok_t tokens[8];
+    int i;
+
+    len += sprintf(js + len, " [");
+    for (i = 0; i < 300; i++)
+        len += sprintf(js + len, "%s{\"id\": %d, \"s\": \"[%d]\"}",
+                       i ? ", " : "", i, i);
+    len += sprintf(js + len, "]\n");
+
+    jsmn_reader_init_buffer(&r, js, len);
+    check(jsmn_seek_index_build(&idx, &r, 1000) == 0);
+    check(idx.count == 300 && idx.array_start == 1 && idx.text_len == len);
+    check(idx.num_points > 5 && idx.num_points < 30);
+    check(idx.points[0].offset == 2 && idx.points[0].ordinal == 0);
+    check(idx.points[1].offset - idx.points[0].offset >= 1000);
+
+    check(jsmn_seek_element(&idx, js, len, 217, &start, &end) == 0);
+    jsmn_init(&p);
+    check(jsmn_parse(&p, js + start, end - start, tokens, 8) == 5);
+    check(tokens[0].type == JSMN_OBJECT && tokens[0].end == (jsmnint_t)(end - start));
+    check(!strncmp(js + start, "{\"id\": 217, \"s\": \"[217]\"}", end - start));
+    check(jsmn_seek_element(&idx, js, len, 299, &start, &end) == 0);
+    check(js[end] == ']');
+    check(jsmn_seek_element(&idx, js, len, 300, &start, &end) ==
+          JSMN_ERROR_NOFOUND);
+    check(jsmn_seek_element(&idx, js, len - 1, 0, &start, &end) ==
+          JSMN_ERROR_INVAL);
+
+    /* persisted index, resumed on a streaming reader */
+    check(jsmn_seek_index_save(&idx, path) == 0);
+    check(jsmn_seek_index_load(&loaded, path, js, len) == 0);
+    check(loaded.count == idx.count && loaded.num_points == idx.num_points);
+    check(!memcmp(loaded.points, idx.points,
+                  idx.num_points * sizeof(jsmn_checkpoint)));
+    check(jsmn_seek_index_find(&loaded, 150, &cp) == 0);
+    check(cp.ordinal <= 150 && cp.ordinal > 100);
+    src.js = js + cp.offset;
+    src.pos = 0;
+    src.chunk = 7;
+    check(jsmn_reader_init(&r, read_chunk, &src, NULL, 16) == 0);
+    jsmn_reader_resume(&r, &loaded, &cp);
+    for (i = (int)cp.ordinal; i < 150; i++)
+        check(jsmn_skip_value(&r) == 1);
+    check(jsmn_next(&r, &ev) == 1 && ev.type == JSMN_EVENT_OBJECT_START);
+    check(ev.depth == 1 && !strncmp(js + ev.start, "{\"id\": 150,", 11));
+    jsmn_reader_destroy(&r);
+    jsmn_seek_index_destroy(&loaded);
+
+    /* a streamed build checksums the same text */
+    src.js = js;
+    src.pos = 0;
+    src.chunk = 100;
+    check(jsmn_reader_init(&r, read_chunk, &src, NULL, 64) == 0);
+    check(jsmn_seek_index_build(&loaded, &r, 1000) == 0);
+    check(loaded.text_hash == idx.text_hash);
+    jsmn_reader_destroy(&r);
+    jsmn_seek_index_destroy(&loaded);
+
+    /* stale: same length, one element changed */
+    js[start + 7] = '3';
+    check(jsmn_seek_index_load(&loaded, path, js, len) == JSMN_ERROR_INVAL);
+    check(jsmn_seek_index_load(&loaded, path, NULL, len) == 0);
+    jsmn_seek_index_destroy(&loaded);
+    js[start + 7] = '2';
+    check(jsmn_seek_index_load(&loaded, path, js, len + 1) == JSMN_ERROR_INVAL);
+
+    /* corrupt checkpoints */
+    for (i = 0; i < 5; i++) {
+        jsmn_checkpoint bad[2];
+        FILE *f;
+
+        memcpy(bad, idx.points, sizeof(bad));
+        switch (i) {
+        case 0: bad[0].ordinal = 1; break;
+        case 1: bad[1].offset = bad[0].offset; break;
+        case 2: bad[1].ordinal = bad[0].ordinal; break;
+        case 3: bad[1].offset = len; break;
+        case 4: bad[1].ordinal = 300; break;
+        }
+        check(jsmn_seek_index_save(&idx, path) == 0);
+        check((f = fopen(path, "r+b")) != NULL);
+        /* the points follow the 64 byte header */
+        check(fseek(f, 64, SEEK_SET) == 0);
+        check(fwrite(bad, sizeof(bad), 1, f) == 1);
+        fclose(f);
+        check(jsmn_seek_index_load(&loaded, path, js, len) == JSMN_ERROR_INVAL);
+        check(loaded.points == NULL);
+    }
+    remove(path);
+    jsmn_seek_index_destroy(&idx);
+
+    jsmn_reader_init_buffer(&r, "{\"a\": 1}", 8);
+    check(jsmn_seek_index_build(&idx, &r, 1000) == JSMN_ERROR_WRONG_TYPE);
+    return 0;
+}
+
+int test_keyset(void) {
+    static const char *names[40];
+    static const char *dup[] = {"a", "b", "a"};
+    static char buf[40][8];
+    const char *js = "{\"k7\": 1, \"x\": 2, \"k39\": [3], \"k7\": 4, \"k0\": {}}";
+    jsmntok_t *values[40];
+    jsmntok_t tokens[16];
+    jsmncolumn_t cols[5];
+    int64_t v[5][2];
+    unsigned char ok[5][2];
+    jsmn_keyset ks;
+    int i;
+
+    for (i = 0; i < 40; i++) {
+        sprintf(buf[i], "k%d", i);
+        names[i] = buf[i];
+    }
+    check(jsmn_keyset_init(&ks, names, 40) == 0);
+    for (i = 0; i < 40; i++)
+        check(jsmn_keyset_id(&ks, names[i], strlen(names[i])) == i);
+    check(jsmn_keyset_id(&ks, "k40", 3) == JSMN_KEY_UNKNOWN);
+    check(jsmn_keyset_id(&ks, "k1", 1) == JSMN_KEY_UNKNOWN);
+    check(jsmn_keyset_id(&ks, "", 0) == JSMN_KEY_UNKNOWN);
+
+    check(jsmn_parse_text(js, tokens, 16) == 12);
+    check(jsmn_keyset_token(&ks, js, &tokens[1]) == 7);
+    check(jsmn_keyset_token(&ks, js, &tokens[3]) == JSMN_KEY_UNKNOWN);
+    check(jsmn_keyset_match(&ks, js, tokens, values) == 4);
+    check(values[7] == &tokens[9] && values[39] == &tokens[6]);
+    check(values[0] == &tokens[11] && values[1] == NULL);
+    check(jsmn_keyset_match(&ks, js, &tokens[6], values) == JSMN_ERROR_WRONG_TYPE);
+    jsmn_keyset_destroy(&ks);
+
+    check(jsmn_keyset_init(&ks, dup, 3) == JSMN_ERROR_INVAL);
+    check(jsmn_keyset_init(&ks, dup, 2) == 0);
+    jsmn_keyset_destroy(&ks);
+
+    /* wide column extraction dispatches through a key set */
+    js = "[{\"k4\": 4, \"k0\": 0, \"k2\": 2}, {\"k3\": 3, \"k1\": 1, \"k9\": 9}]";
+    check(jsmn_parse_text(js, tokens, 16) == 15);
+    for (i = 0; i < 5; i++) {
+        cols[i].key = names[i];
+        cols[i].type = JSMN_COLUMN_INT64;
+        cols[i].values = v[i];
+        cols[i].valid = ok[i];
+    }
+    check(jsmn_extract_columns(js, tokens, cols, 5) == 2);
+    for (i = 0; i < 5; i++) {
+        check(ok[i][0] == (i % 2 == 0) && ok[i][1] == (i % 2 == 1));
+        check(v[i][i % 2] == i);
+    }
+    return 0;
+}
+
+int test_intern(void) {
+    const char *rec1 = "{\"id\": 1, \"name\": \"a\", \"tags\": {\"id\": 7}}";
+    const char *rec2 = "{\"name\": \"b\", \"new\": [], \"id\": 2}";
+    char js[64];
+    jsmn_intern in;
+    jsmn_parser p;
+    int32_t id, name;
+    size_t len;
+
+    jsmn_intern_init(&in);
+    jsmn_init(&p);
+    p.intern = &in;
+    check(jsmn_parse_dynamic_str(&p, rec1) == 9);
+    id = jsmn_intern_find(&in, "id", 2);
+    name = jsmn_intern_find(&in, "name", 4);
+    check(id == 0 && name == 1 && in.num_keys == 3);
+    check(p.key_ids[1] == id && p.key_ids[7] == id && p.key_ids[2] == -1);
+    check(jsmn_lookup_id(&p, p.tokens, id) == &p.tokens[2]);
+    check(jsmn_lookup_id(&p, &p.tokens[6], id) == &p.tokens[8]);
+    check(jsmn_lookup_id(&p, p.tokens, 7) == NULL);
+    jsmn_destroy(&p);
+
+    /* the next record reuses the ids and adds only the new key */
+    jsmn_init(&p);
+    p.intern = &in;
+    check(jsmn_parse_dynamic_str(&p, rec2) == 7);
+    check(in.num_keys == 4 && jsmn_intern_find(&in, "id", 2) == id);
+    check(p.key_ids[1] == name && p.key_ids[5] == id);
+    check(jsmn_lookup_id(&p, p.tokens, id) == &p.tokens[6]);
+    check(!strncmp(jsmn_intern_name(&in, 3, &len), "new", 3) && len == 3);
+    check(jsmn_intern_name(&in, 4, &len) == NULL);
+    check(jsmn_intern_find(&in, "nam", 3) == JSMN_KEY_UNKNOWN);
+
+#ifdef JSMN_PARENT_LINKS
+    /* ids follow their tokens through a reparse */
+    strcpy(js, rec2);
+    edit(js, 21, 2, "{\"k\": 1}");
+    check(jsmn_reparse(&p, js, strlen(js), 21, 2, 8) == 9);
+    check(jsmn_intern_find(&in, "k", 1) == 4);
+    check(p.key_ids[5] == 4 && p.key_ids[7] == id);
+    check(jsmn_lookup_id(&p, p.tokens, id) == &p.tokens[8]);
+#else
+    (void)js;
+#endif
+    jsmn_destroy(&p);
+
+    /* enough keys to grow the table */
+    name = in.num_keys;
+    for (id = 0; id < 100; id++) {
+        sprintf(js, "key%d", (int)id);
+        check(jsmn_intern_id(&in, js, strlen(js)) == name + id);
+    }
+    check(jsmn_intern_id(&in, "key50", 5) == name + 50);
+    jsmn_intern_destroy(&in);
+    return 0;
+}
+
+int test_shape(void) {
+    static const char *keys[] = {"a", "c", "zz"};
+    const char *js = "[{\"a\": 1, \"b\": [2], \"c\": 3}, "
+                     "{\"a\": 4, \"b\": [5], \"c\": 6}, {\"c\": 7, \"a\": 8}, "
+                     "{\"b\": {\"x\": 0, \"c\": 0}, \"c\": 9}]";
+    jsmntok_t tokens[32], *t, *v;
+    jsmn_parser p;
+    jsmn_shape shape;
+    char out[8] = "";
+    int i;
+
+    jsmn_init(&p);
+    check(jsmn_parse(&p, js, strlen(js), tokens, 32) == 31);
+    check(jsmn_shape_init(&shape, keys, 3) == 0);
+
+    t = jsmn_array_first(tokens);
+    for (i = 0; i < tokens[0].size; i++, t = jsmn_array_next(t)) {
+        v = jsmn_shape_lookup(&shape, &p, js, t, 1);
+        check(v != NULL && v->type == JSMN_PRIMITIVE);
+        strncat(out, js + v->start, 1);
+    }
+    check(!strcmp(out, "3679"));
+    /* only the second record has the shape of the one before it */
+    check(shape.hits == 1 && shape.misses == 3);
+
+    /* an offset that lands on a nested key of the same name is a miss */
+    shape.offsets[1] = 5;
+    check(jsmn_shape_lookup(&shape, &p, js, &tokens[22], 1) == &tokens[30]);
+    check(shape.misses == 4);
+
+    check(jsmn_shape_lookup(&shape, &p, js, &tokens[1], 0) == &tokens[3]);
+    check(jsmn_shape_lookup(&shape, &p, js, &tokens[9], 0) == &tokens[11]);
+    check(shape.hits == 2);
+    check(jsmn_shape_lookup(&shape, &p, js, &tokens[1], 2) == NULL);
+    check(jsmn_shape_lookup(&shape, &p, js, &tokens[1], 3) == NULL);
+    check(jsmn_shape_lookup(&shape, &p, js, &tokens[5], 0) == NULL);
+    jsmn_shape_destroy(&shape);
+    return 0;
+}
+
+int test_pool(void) {
+    char js[4096];
+    jsmn_pool pool;
+    jsmn_parser *p, *q;
+    jsmntok_t *tokens;
+    size_t len;
+    int i, n;
+
+    /* 1000 tokens in about 2k, denser than the first guess */
+    strcpy(js, "[");
+    for (i = 0; i < 999; i++)
+        strcat(js, i ? ",1" : "1");
+    strcat(js, "]");
+    len = strlen(js);
+
+    check(jsmn_pool_init(&pool, 2) == 0);
+    p = jsmn_pool_get(&pool, len);
+    check(p != NULL && p->num_tokens < 1000);
+    check(jsmn_parse_dynamic(p, js, len) == 1000);
+    jsmn_pool_put(&pool, p);
+
+    /* the same parser comes back warm and parses in place */
+    q = jsmn_pool_get(&pool, len);
+    check(q == p && q->toknext == 0 && q->pos == 0);
+    tokens = q->tokens;
+    check(jsmn_parse_dynamic(q, js, len) == 1000 && q->tokens == tokens);
+    jsmn_pool_put(&pool, q);
+
+    /* after a few documents a cold parser is sized from the average */
+    for (i = 0; i < 16; i++) {
+        p = jsmn_pool_get(&pool, len);
+        check(jsmn_parse_dynamic(p, js, len) == 1000);
+        jsmn_pool_put(&pool, p);
+    }
+    p = jsmn_pool_get(&pool, len);
+    q = jsmn_pool_get(&pool, len);
+    check(q != p && q->num_tokens >= 1000 && q->num_tokens < 2000);
+    check(jsmn_parse_dynamic(q, js, len) == 1000);
+    jsmn_pool_put(&pool, q);
+    jsmn_pool_put(&pool, p);
+    p = jsmn_pool_get(&pool, 3);
+    check(p != NULL);
+    jsmn_pool_put(&pool, p);
+    jsmn_pool_destroy(&pool);
+
+    /* reset keeps owned tokens, drops borrowed ones */
+    p = malloc(sizeof(*p));
+    jsmn_init(p);
+    check(jsmn_reserve(p, 100) == 0 && p->owns_tokens);
+    tokens = p->tokens;
+    n = jsmn_parse_dynamic_str(p, "[1, 2]");
+    check(n == 3);
+    jsmn_reset(p);
+    check(p->tokens == tokens && p->num_tokens == 100 && p->toknext == 0);
+    jsmn_destroy(p);
+    jsmn_init(p);
+    check(jsmn_parse(p, "[1]", 3, tokens = malloc(4 * sizeof(jsmntok_t)), 4) == 2);
+    check(jsmn_reserve(p, 8) == JSMN_ERROR_NOMEM);
+    jsmn_reset(p);
+    check(p->tokens == NULL);
+    free(tokens);
+    free(p);
+    return 0;
+}
+
+#ifdef JSMN_PARENT_LINKS
+static uint64_t fingerprint(const char *js, int mode, int i) {
+    jsmn_parser p;
+    uint64_t h = 0;
+
+    jsmn_init(&p);
+    p.fingerprint = mode;
+    if (jsmn_parse_dynamic_str(&p, js) > i)
+        h = p.hashes[i];
+    jsmn_destroy(&p);
+    return h;
+}
+#endif
+
+int test_fingerprint(void) {
+#ifdef JSMN_PARENT_LINKS
+    const int o = JSMN_FINGERPRINT_ORDERED, u = JSMN_FINGERPRINT_UNORDERED;
+    const char *a = "{\"a\": [1, {\"b\": null}], \"c\": \"x\"}";
+    jsmn_parser p;
+    char js[64];
+
+    check(fingerprint(a, o, 0) != 0);
+    check(fingerprint(a, o, 0) ==
+          fingerprint(" {\"a\":[ 1,{\"b\" :null} ] ,\n\"c\":\"x\" }", o, 0));
+    check(fingerprint(a, o, 0) != fingerprint("{\"a\": [1, {\"b\": null}], \"c\": \"y\"}", o, 0));
+    check(fingerprint(a, o, 0) != fingerprint("{\"a\": [1, {\"b\": null}], \"c\": x}", o, 0));
+    check(fingerprint(a, o, 0) != fingerprint("{\"a\": [{\"b\": null}, 1], \"c\": \"x\"}", o, 0));
+    check(fingerprint("[[1], 2]", o, 0) != fingerprint("[[1, 2]]", o, 0));
+    check(fingerprint("{\"a\": 1, \"b\": 2}", o, 0) != fingerprint("{\"a\": 2, \"b\": 1}", o, 0));
+
+    /* member order only matters when ordered, array order always does */
+    check(fingerprint(a, o, 0) != fingerprint("{\"c\": \"x\", \"a\": [1, {\"b\": null}]}", o, 0));
+    check(fingerprint(a, u, 0) == fingerprint("{\"c\": \"x\", \"a\": [1, {\"b\": null}]}", u, 0));
+    check(fingerprint("{\"a\": 1, \"b\": 2}", u, 0) != fingerprint("{\"a\": 2, \"b\": 1}", u, 0));
+    check(fingerprint("[1, 2]", u, 0) != fingerprint("[2, 1]", u, 0));
+
+    /* subtrees hash the same wherever they are */
+    check(fingerprint(a, o, 2) == fingerprint("[[1, {\"b\": null}]]", o, 1));
+    check(fingerprint(a, o, 4) == fingerprint("{\"b\": null}", o, 0));
+
+    /* a reparse leaves the hashes of a fresh parse */
+    strcpy(js, a);
+    jsmn_init(&p);
+    p.fingerprint = u;
+    check(jsmn_parse_dynamic_str(&p, js) == 9);
+    edit(js, 16, 4, "true, \"d\": []");
+    check(jsmn_reparse(&p, js, strlen(js), 16, 4, 13) == 11);
+    check(p.hashes[0] == fingerprint(js, u, 0));
+    check(p.hashes[3] == fingerprint(js, u, 3));
+    check(p.hashes[1] == fingerprint(js, u, 1));
+    check(p.hashes[9] == fingerprint(js, u, 9));
+    jsmn_destroy(&p);
+#endif
+    return 0;
+}
+
+static int log_diff(void *user, jsmndiff_t kind, const char *path,
+                    jsmntok_t *old_value, jsmntok_t *new_value) {
+    char *out = user;
+    (void)old_value;
+    (void)new_value;
+    sprintf(out + strlen(out), "%c%s ", " +-~"[kind], path);
+    return 0;
+}
+
+static int stop_diff(void *user, jsmndiff_t kind, const char *path,
+                     jsmntok_t *old_value, jsmntok_t *new_value) {
+    (void)user, (void)kind, (void)path, (void)old_value, (void)new_value;
+    return 1;
+}
+
+int test_diff(void) {
+    const char *a = "{\"id\": 1, \"tags\": [\"x\", \"y\", \"z\"], \"a/b\": {\"k\": 1}, "
+                    "\"gone\": null, \"same\": {\"deep\": [1, [2]]}, \"t\": 1}";
+    const char *b = "{\"same\": {\"deep\": [1, [2]]}, \"id\": 2, \"a/b\": {\"k\": 1, \"n\": []}, "
+                    "\"t\": \"1\", \"tags\": [\"x\", \"w\"], \"new\": {}}";
+    jsmntok_t ta[32], tb[32];
+    char out[256] = "";
+
+    check(jsmn_parse_text(a, ta, 32) > 0);
+    check(jsmn_parse_text(b, tb, 32) > 0);
+    check(jsmn_diff(a, ta, b, tb, log_diff, out) == 7);
+    check(!strcmp(out, "~/id ~/tags/1 -/tags/2 +/a~1b/n -/gone ~/t +/new "));
+
+    /* nothing reported for equal documents, even with other whitespace */
+    out[0] = '\0';
+    check(jsmn_parse_text("[1, {\"a\": 2}]", tb, 32) == 5);
+    check(jsmn_parse_text("[1,{\"a\":2}]", ta, 32) == 5);
+    check(jsmn_diff("[1,{\"a\":2}]", ta, "[1, {\"a\": 2}]", tb, log_diff, out) == 0);
+    check(out[0] == '\0');
+    check(jsmn_diff("[1,{\"a\":2}]", ta, "[1, {\"a\": 2}]", tb, NULL, NULL) == 0);
+
+    /* a root that changes type is one change */
+    check(jsmn_parse_text("{}", tb, 32) == 1);
+    check(jsmn_diff("[1,{\"a\":2}]", ta, "{}", tb, log_diff, out) == 1);
+    check(!strcmp(out, "~ "));
+    check(jsmn_diff("[1,{\"a\":2}]", ta, "{}", tb, stop_diff, NULL) == JSMN_ERROR_STOPPED);
+
+    /* siblings after nested values are found at every level */
+    out[0] = '\0';
+    check(jsmn_parse_text("[[1, [2, 3]], {\"k\": [4], \"j\": {}}, 5]", ta, 32) == 13);
+    check(jsmn_parse_text("[[1, [2, 4]], {\"k\": [4, 6], \"j\": {}}, 5, 7]", tb, 32) == 15);
+    check(jsmn_diff("[[1, [2, 3]], {\"k\": [4], \"j\": {}}, 5]", ta,
+                    "[[1, [2, 4]], {\"k\": [4, 6], \"j\": {}}, 5, 7]", tb, log_diff, out) == 3);
+    check(!strcmp(out, "~/0/1/1 +/1/k/1 +/3 "));
+
+#ifdef JSMN_PARENT_LINKS
+    {
+        /* fingerprints give the same differences */
+        jsmn_parser pa, pb;
+
+        jsmn_init(&pa);
+        jsmn_init(&pb);
+        pa.fingerprint = pb.fingerprint = JSMN_FINGERPRINT_ORDERED;
+        check(jsmn_parse_dynamic_str(&pa, a) > 0);
+        check(jsmn_parse_dynamic_str(&pb, b) > 0);
+        out[0] = '\0';
+        check(jsmn_diff_hashed(a, pa.tokens, pa.hashes, b, pb.tokens, pb.hashes,
+                               log_diff, out) == 7);
+        check(!strcmp(out, "~/id ~/tags/1 -/tags/2 +/a~1b/n -/gone ~/t +/new "));
+        out[0] = '\0';
+        check(jsmn_diff_hashed(a, pa.tokens + 1, pa.hashes + 1, b, pb.tokens + 1,
+                               pb.hashes + 1, log_diff, out) == 1);
+        check(!strcmp(out, "~ "));
+        jsmn_destroy(&pa);
+        jsmn_destroy(&pb);
+    }
+#endif
+    return 0;
+}
+
+int test_binary(void) {
+    const char *js = "{\"a\": [1, -1, 300, -200, 1.5, true, null], \"s\": \"x\\u00e9\\n\"}";
+    static const unsigned char msgpack[] = {
+        0x82, 0xa1, 'a', 0x97, 0x01, 0xff, 0xcd, 0x01, 0x2c, 0xd1, 0xff, 0x38,
+        0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0, 0xc3, 0xc0,
+        0xa1, 's', 0xa4, 'x', 0xc3, 0xa9, '\n'};
+    static const unsigned char cbor[] = {
+        0xa2, 0x61, 'a', 0x87, 0x01, 0x20, 0x19, 0x01, 0x2c, 0x38, 0xc7,
+        0xfb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0, 0xf5, 0xf6,
+        0x61, 's', 0x64, 'x', 0xc3, 0xa9, '\n'};
+    const char *big = "[9223372036854775808, -9223372036854775808, \"\\u0041\\u0042\\u0043"
+                      "\\u0044\\u0045\\u0046\", \"\\ud83d\\ude00\"]";
+    static const unsigned char big_msgpack[] = {
+        0x94, 0xcb, 0x43, 0xe0, 0, 0, 0, 0, 0, 0,
+        0xd3, 0x80, 0, 0, 0, 0, 0, 0, 0,
+        0xa6, 'A', 'B', 'C', 'D', 'E', 'F',
+        0xa4, 0xf0, 0x9f, 0x98, 0x80};
+    jsmntok_t tokens[16];
+    jsmn_writer w;
+    char buf[8];
+
+    check(jsmn_parse_text(js, tokens, 16) == 12);
+    check(jsmn_writer_init(&w, NULL, 4) == 0);
+    check(jsmn_transcode_binary(js, tokens, JSMN_MSGPACK, &w) == 12);
+    check(w.len == sizeof(msgpack) && !memcmp(w.buf, msgpack, w.len));
+    jsmn_writer_reset(&w);
+    check(jsmn_transcode_binary(js, tokens, JSMN_CBOR, &w) == 12);
+    check(w.len == sizeof(cbor) && !memcmp(w.buf, cbor, w.len));
+    check(jsmn_transcode_binary(js, &tokens[2], JSMN_CBOR, &w) == 8);
+    check(w.len == sizeof(cbor) + 19 && !memcmp(w.buf + sizeof(cbor), cbor + 3, 19));
+
+    jsmn_writer_reset(&w);
+    check(jsmn_parse_text(big, tokens, 16) == 5);
+    check(jsmn_transcode_binary(big, tokens, JSMN_MSGPACK, &w) == 5);
+    check(w.len == sizeof(big_msgpack) && !memcmp(w.buf, big_msgpack, w.len));
+#ifndef JSMN_STRICT
+    jsmn_writer_reset(&w);
+    check(jsmn_parse_text("{a: b}", tokens, 16) == 3);
+    check(jsmn_transcode_binary("{a: b}", tokens, JSMN_CBOR, &w) == 3);
+    check(w.len == 5 && !memcmp(w.buf, "\xa1\x61\x61\x61\x62", 5));
+#endif
+    jsmn_writer_destroy(&w);
+
+    /* a caller buffer that is too small */
+    check(jsmn_writer_init(&w, buf, sizeof(buf)) == 0);
+    check(jsmn_transcode_binary(big, tokens, JSMN_CBOR, &w) == JSMN_ERROR_NOMEM);
+    /* escapes the parser lets through are checked on output */
+    tokens[0].type = JSMN_STRING;
+    tokens[0].start = 1;
+    tokens[0].end = 5;
+    jsmn_writer_reset(&w);
+    check(jsmn_transcode_binary("\"\\u12\"", tokens, JSMN_CBOR, &w) == JSMN_ERROR_INVAL);
+    return 0;
+}
+
+int test_parse_binary(void) {
+    const char *js = "{\"id\": -70000, \"tags\": [\"a\", \"bc\"], \"pos\": {\"x\": 1.5, "
+                     "\"y\": 300}, \"ok\": true, \"none\": null}";
+    static const unsigned char cbor[] = {
+        0xc1, 0x82, 0xf9, 0x3e, 0x00, 0xd8, 0x20, 0x61, 'u'};
+    jsmntok_t text[32], tokens[32], *t;
+    jsmn_parser p;
+    jsmn_writer w;
+    int n, i, b;
+    int64_t v;
+    double d;
+
+    n = jsmn_parse_text(js, text, 32);
+    check(n == 17);
+    check(jsmn_writer_init(&w, NULL, 0) == 0);
+    for (i = 0; i < 2; i++) {
+        jsmn_writer_reset(&w);
+        check(jsmn_transcode_binary(js, text, (jsmnbinary_t)i, &w) == n);
+        jsmn_init(&p);
+        check(jsmn_parse_binary(&p, w.buf, w.len, (jsmnbinary_t)i, tokens, 32) == n);
+        for (b = 0; b < n; b++) {
+            check(tokens[b].type == text[b].type && tokens[b].size == text[b].size);
+#ifdef JSMN_PARENT_LINKS
+            check(tokens[b].parent == text[b].parent);
+#endif
+        }
+        check(tokens[0].start == 0 && tokens[0].end == (jsmnint_t)w.len);
+
+        /* the lookup helpers work on the binary buffer */
+        t = jsmn_lookup(w.buf, tokens, "id");
+        check(jsmn_binary_int64(w.buf, t, (jsmnbinary_t)i, &v) && v == -70000);
+        t = jsmn_find(w.buf, tokens, "oa", "tags", 1);
+        check(t && t->end - t->start == 2 && !memcmp(w.buf + t->start, "bc", 2));
+        t = jsmn_pointer(w.buf, tokens, "/pos/x");
+        check(jsmn_binary_double(w.buf, t, (jsmnbinary_t)i, &d) && d == 1.5);
+        check(!jsmn_binary_int64(w.buf, t, (jsmnbinary_t)i, &v));
+        t = jsmn_pointer(w.buf, tokens, "/pos/y");
+        check(jsmn_binary_double(w.buf, t, (jsmnbinary_t)i, &d) && d == 300);
+        t = jsmn_lookup(w.buf, tokens, "ok");
+        check(jsmn_binary_bool(w.buf, t, (jsmnbinary_t)i, &b) && b == 1);
+        check(!jsmn_binary_null(w.buf, t, (jsmnbinary_t)i));
+        check(jsmn_binary_null(w.buf, jsmn_lookup(w.buf, tokens, "none"), (jsmnbinary_t)i));
+
+        /* truncated input */
+        jsmn_init(&p);
+        check(jsmn_parse_binary(&p, w.buf, w.len - 1, (jsmnbinary_t)i, tokens, 32) ==
+              JSMN_ERROR_PART);
+        check(jsmn_parse_binary(&p, w.buf, w.len, (jsmnbinary_t)i, tokens, 32) == n);
+        jsmn_init(&p);
+        check(jsmn_parse_binary(&p, w.buf, w.len, (jsmnbinary_t)i, tokens, 8) ==
+              JSMN_ERROR_NOMEM);
+        check(p.toknext == 0);
+        check(jsmn_parse_binary(&p, w.buf, w.len, (jsmnbinary_t)i, tokens, 32) == n);
+        check(tokens[0].end == (jsmnint_t)w.len);
+    }
+    jsmn_writer_destroy(&w);
+
+    /* tags are skipped, half floats read */
+    jsmn_init(&p);
+    check(jsmn_parse_binary(&p, (const char *)cbor + 1, sizeof(cbor) - 1, JSMN_CBOR, NULL, 0) == 3);
+    check(p.tokens[0].type == JSMN_ARRAY && p.tokens[0].size == 2);
+    check(jsmn_binary_double((const char *)cbor + 1, &p.tokens[1], JSMN_CBOR, &d) && d == 1.5);
+    check(p.tokens[2].type == JSMN_STRING && p.tokens[2].start == 7);
+    jsmn_destroy(&p);
+
+    /* reserved and indefinite lengths */
+    jsmn_init(&p);
+    check(jsmn_parse_binary(&p, "\x9f\xff", 2, JSMN_CBOR, tokens, 32) == JSMN_ERROR_INVAL);
+    jsmn_init(&p);
+    check(jsmn_parse_binary(&p, (const char *)cbor, 1, JSMN_MSGPACK, tokens, 32) == JSMN_ERROR_INVAL);
+    if (sizeof(size_t) > sizeof(jsmnint_t)) {
+        jsmn_init(&p);
+        check(jsmn_parse_binary(&p, "\xc0", JSMN_MAX_LEN + 1, JSMN_MSGPACK, tokens, 32) ==
+              JSMN_ERROR_INVAL);
+    }
+    return 0;
+}
+
+int test_index(void) {
+    const char *js = "[{\"id\": 30, \"name\": \"c\"}, {\"id\": 10, \"name\": \"a\"}, "
+                     "{\"name\": \"x\"}, {\"id\": 20.5, \"name\": \"b\"}, 7, "
+                     "{\"id\": 10, \"name\": \"a\", \"dup\": 1}, {\"id\": \"s\"}]";
+    jsmntok_t tokens[40], *t;
+    jsmn_index byid, byname;
+    size_t first;
+
+    check(jsmn_parse_text(js, tokens, 40) == 30);
+    check(jsmn_index_build(&byid, js, tokens, "/id", JSMN_INDEX_NUMBER) == 4);
+    check(jsmn_index_build(&byname, js, tokens, "/name", JSMN_INDEX_STRING) == 5);
+
+    check(jsmn_index_find_number(&byid, 30) == &tokens[1]);
+    check(jsmn_index_find_number(&byid, 20.5) == jsmn_array_at(tokens, 3));
+    /* equal keys come back in array order */
+    check(jsmn_index_find_number(&byid, 10) == &tokens[6]);
+    check(byid.entries[1].element == jsmn_array_at(tokens, 5));
+    check(jsmn_index_find_number(&byid, 11) == NULL);
+    check(jsmn_index_find(&byid, "10", 2) == NULL);
+
+    check(jsmn_index_range(&byid, 10, 25, &first) == 3 && first == 0);
+    check(jsmn_index_range(&byid, 15, 100, &first) == 2);
+    check(byid.entries[first].number == 20.5);
+    check(jsmn_index_range(&byid, 31, 100, &first) == 0);
+    check(jsmn_index_range(&byid, 5, 1, &first) == 0);
+
+    t = jsmn_index_find(&byname, "b", 1);
+    check(t == jsmn_array_at(tokens, 3));
+    check(jsmn_index_find(&byname, "x", 1) == jsmn_array_at(tokens, 2));
+    check(jsmn_index_find(&byname, "", 0) == NULL);
+    check(jsmn_index_find(&byname, "ab", 2) == NULL);
+    jsmn_index_destroy(&byid);
+    jsmn_index_destroy(&byname);
+
+    check(jsmn_index_build(&byid, js, &tokens[1], "/id", JSMN_INDEX_NUMBER) ==
+          JSMN_ERROR_WRONG_TYPE);
+    return 0;
+}
+
+int test_elements(void) {
+    const char *js = "{\"rows\": [[1, [2, 3]], {\"a\": [4]}, 5, [], \"x\"], \"b\": [6]}";
+    jsmntok_t tokens[32], *rows;
+    jsmn_elements el;
+    int n, i;
+
+    n = jsmn_parse_text(js, tokens, 32);
+    check(n == 18);
+#ifdef JSMN_PARENT_LINKS
+    check(jsmn_elements_build(&el, tokens, n) == 0);
+    rows = jsmn_lookup(js, tokens, "rows");
+    for (i = 0; i < 6; i++)
+        check(jsmn_elements_at(&el, rows, i) == jsmn_array_at(rows, i));
+    check(jsmn_elements_at(&el, rows, 2)->start == (jsmnint_t)(strchr(js, '5') - js));
+    check(jsmn_elements_at(&el, &tokens[1], 0) == NULL);
+    check(jsmn_elements_at(&el, rows, (size_t)-1) == NULL);
+    check(jsmn_elements_find(&el, js, tokens, "oaaa", "rows", 0, 1, 1) ==
+          jsmn_find(js, tokens, "oaaa", "rows", 0, 1, 1));
+    check(jsmn_elements_find(&el, js, tokens, "oaoa", "rows", 1, "a", 0)->start ==
+          (jsmnint_t)(strchr(js, '4') - js));
+    check(jsmn_elements_find(&el, js, tokens, "oa", "b", 0)->start ==
+          (jsmnint_t)(strchr(js, '6') - js));
+    check(jsmn_elements_find(&el, js, tokens, "oa", "rows", 5) == NULL);
+    jsmn_elements_destroy(&el);
+#else
+    (void)rows, (void)i, (void)el;
+#endif
+    return 0;
+}
+
+int test_budget(void) {
+    char js[4096];
+    jsmntok_t tokens[8];
+    jsmn_parser p, full;
+    int i, calls = 0;
+    jsmnint_t r;
+
+    /* a document tokenized in slices equals one parse */
+    strcpy(js, "[");
+    for (i = 0; i < 200; i++)
+        strcat(js, i ? ", {\"k\": [1, \"two\"]}" : "{\"k\": [1, \"two\"]}");
+    strcat(js, "]");
+    jsmn_init(&full);
+    check(jsmn_parse_dynamic_str(&full, js) == 1001);
+    jsmn_init(&p);
+    p.max_bytes = 100;
+    while ((r = jsmn_parse_dynamic(&p, js, strlen(js))) == JSMN_YIELD)
+        calls++;
+    check(r == 1001 && calls > 30 && calls <= (int)strlen(js) / 100);
+    for (i = 0; i < 1001; i++)
+        check(p.tokens[i].type == full.tokens[i].type &&
+              p.tokens[i].start == full.tokens[i].start &&
+              p.tokens[i].end == full.tokens[i].end &&
+              p.tokens[i].size == full.tokens[i].size);
+    jsmn_destroy(&p);
+
+    /* one long token is lexed in slices too, escapes cut anywhere */
+    {
+        size_t n = 1 << 20, last = 0;
+        char *big = malloc(n + 16);
+        int bad = 0;
+
+        check(big != NULL);
+        for (i = 0; i < 2; i++) {
+            strcpy(big, i ? "[1" : "[\"");
+            memset(big + 2, i ? '1' : 'a', n);
+            if (!i)
+                for (last = 2; last + 8 < n; last += 997)
+                    memcpy(big + last, last % 2 ? "\\u00e9" : "\\\\", last % 2 ? 6 : 2);
+            strcpy(big + 2 + n, i ? "]" : "\"]");
+            jsmn_init(&p);
+            p.max_bytes = 100;
+            calls = 0;
+            last = 0;
+            while ((r = jsmn_parse(&p, big, strlen(big), tokens, 8)) == JSMN_YIELD) {
+                if (p.lexed && (p.lexed <= last || p.lexed - last > 100 + (last ? 0 : 2)))
+                    bad++;
+                last = p.lexed;
+                calls++;
+            }
+            check(r == 2 && !bad && calls >= (int)(n / 100));
+            check(tokens[1].start == 1 + !i && tokens[1].end == (jsmnint_t)(n + 2));
+        }
+        free(big);
+    }
+
+    /* token limit bounds the dynamic storage too */
+    jsmn_init(&p);
+    p.max_tokens = 100;
+    check(jsmn_parse_dynamic_str(&p, js) == JSMN_ERROR_LIMIT);
+    check(p.num_tokens == 100 && p.toknext == 100);
+    jsmn_destroy(&p);
+    jsmn_init(&p);
+    p.max_tokens = 1001;
+    check(jsmn_parse(&p, js, strlen(js), full.tokens, 1001) == 1001);
+    jsmn_init(&p);
+    p.max_tokens = 4;
+    check(jsmn_parse(&p, js, strlen(js), full.tokens, 1001) == JSMN_ERROR_LIMIT);
+    jsmn_init(&p);
+    check(jsmn_parse(&p, js, strlen(js), tokens, 8) == JSMN_ERROR_NOMEM);
+    jsmn_destroy(&full);
+
+    /* depth limit */
+    jsmn_init(&p);
+    p.max_depth = 3;
+    check(jsmn_parse(&p, "[[[1]], [[2]]]", 14, tokens, 8) == 7);
+    jsmn_init(&p);
+    p.max_depth = 3;
+    check(jsmn_parse(&p, "[[[[1]]]]", 9, tokens, 8) == JSMN_ERROR_LIMIT);
+    check(!strcmp(jsmn_strerror(JSMN_YIELD), "jsmn: Byte budget used, parse again to continue"));
+    return 0;
+}
+
 int main(void) {
     test(test_empty, "test for a empty JSON objects/arrays");
     test(test_object, "test for a JSON objects");
@@ -418,6 +1993,29 @@ int main(void) {
     test(test_count, "test tokens count estimation");
     test(test_nonstrict, "test for non-strict mode");
     test(test_unmatched_brackets, "test for unmatched brackets");
+    test(test_columns, "test columnar extraction from array of objects");
+    test(test_events, "test tokenless event parsing");
+    test(test_reader, "test pull parser over a sliding window");
+    test(test_filter, "test streaming filter over NDJSON");
+    test(test_writer, "test JSON writer");
+    test(test_transcode, "test minify and pretty print");
+    test(test_patch, "test splice based JSON patch");
+    test(test_reparse, "test incremental re-parse after an edit");
+    test(test_cache, "test persisted token cache");
+    test(test_parse_file, "test parsing a memory mapped file");
+    test(test_offset_width, "test offset type selected by JSMN_LARGE");
+    test(test_seek_index, "test sparse seek index over a top level array");
+    test(test_keyset, "test key set matcher");
+    test(test_intern, "test key interning across parses");
+    test(test_shape, "test shape cache lookups");
+    test(test_pool, "test parser pool and reset");
+    test(test_fingerprint, "test structural fingerprints");
+    test(test_diff, "test structural diff");
+    test(test_binary, "test MessagePack and CBOR output");
+    test(test_parse_binary, "test parsing MessagePack and CBOR into tokens");
+    test(test_index, "test secondary index over an array");
+    test(test_elements, "test constant time array element access");
+    test(test_budget, "test parse budget and yielding");
     printf("\nPASSED: %d\nFAILED: %d\n", test_passed, test_failed);
     return (test_failed > 0);
 }
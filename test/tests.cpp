@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "../jsmn.hpp"
+#include "test.h"
+
+static const char *docs[] = {
+    "{}",
+    "[1, 2.5, true, null, \"x\"]",
+    "{\"a\": {\"b\": [1, {\"c\": \"d\"}]}, \"e\": [[], {}], \"f\": \"\\u00e9\"}",
+    "[{\"id\": 1, \"tags\": [\"a\", \"b\"]}, {\"id\": 2, \"tags\": []}]",
+    "{a: 1, b: [x, y]}",
+    "{\"a\" 1}",
+    "{\"a\": 1,}",
+    "[1, 2",
+    "[1 2]",
+    "[tru]",
+    "\"a\\q\"",
+    "{\"a\": [1]} 2",
+};
+
+/* the grammar jsmn_parse was built with, the test_cpp_strict target
+   links a JSMN_STRICT build */
+#ifdef JSMN_STRICT
+static constexpr bool c_strict = true;
+#else
+static constexpr bool c_strict = false;
+#endif
+
+/* tokens of the C++ parser with policy P equal those of jsmn_parse */
+template <class P>
+static int same_as_c(const char *js) {
+    jsmntok_t c[64];
+    jsmn::token<P> t[64];
+    jsmn_parser p;
+    jsmn::parser<P> cpp;
+    int n, i;
+
+    jsmn_init(&p);
+    n = jsmn_parse(&p, js, strlen(js), c, 64);
+    if (cpp.parse(js, t, 64) != n)
+        return 0;
+    for (i = 0; i < n; i++) {
+        if (t[i].type != c[i].type || t[i].start != c[i].start ||
+                t[i].end != c[i].end || t[i].size != c[i].size)
+            return 0;
+        if constexpr (P::parent_links)
+            if (t[i].parent != c[i].parent)
+                return 0;
+    }
+    return 1;
+}
+
+int test_cpp_parity(void) {
+    size_t i;
+    for (i = 0; i < sizeof(docs) / sizeof(docs[0]); i++) {
+        check(same_as_c<jsmn::policy<c_strict>>(docs[i]));
+        check((same_as_c<jsmn::policy<c_strict, true, int, false>>(docs[i])));
+        check((same_as_c<jsmn::policy<c_strict, true, std::int64_t>>(docs[i])));
+        check((same_as_c<jsmn::policy<c_strict, false, int, true>>(docs[i])));
+    }
+    return 0;
+}
+
+int test_cpp_policies(void) {
+    jsmn::token<jsmn::lenient> t[8];
+    jsmn::token<jsmn::strict> s[8];
+    jsmn::parser<jsmn::lenient> lenient;
+    jsmn::parser<jsmn::strict> strict;
+
+    check(sizeof(jsmn::token<jsmn::compat>) == sizeof(jsmntok_t));
+    check(sizeof(jsmn::token<jsmn::policy<false, false, int, false>>) <
+          sizeof(jsmn::token<jsmn::compat>));
+    check(sizeof(jsmn::token<jsmn::large>().start) == 8);
+
+    /* one binary, two grammars */
+    check(lenient.parse("{a: 1}", t, 8) == 3);
+    check(strict.parse("{a: 1}", s, 8) == JSMN_ERROR_INVAL);
+    check(strict.parse("{\"a\": 1}", s, 8) == 3);
+    check(strict.parse("[1, 2", s, 8) == JSMN_ERROR_PART);
+    check(lenient.parse("[1, [2]", t, 8) == JSMN_ERROR_PART);
+    check(lenient.parse("[1, 2, 3]", t, 3) == JSMN_ERROR_NOMEM);
+    check(lenient.parse("[1}", t, 8) == JSMN_ERROR_INVAL);
+
+    /* input longer than the offset type can address */
+    {
+        jsmn::parser<jsmn::policy<false, true, short>> narrow;
+        jsmn::token<jsmn::policy<false, true, short>> n[2];
+        std::string big(40000, ' ');
+        big[0] = '1';
+        check(narrow.parse(big, n, 2) == JSMN_ERROR_INVAL);
+        check(narrow.parse(big.substr(0, 32767), n, 2) == 1);
+    }
+
+    /* subtree length lets siblings be found by addition */
+    check(lenient.parse("[[1, [2]], 3]", t, 8) == 6);
+    check(t[0].skip == 6 && t[1].skip == 4 && t[3].skip == 2 && t[5].skip == 1);
+    return 0;
+}
+
+template <class P>
+static int navigate(void) {
+    const char *js = docs[2];
+    jsmn::document<P> doc;
+    std::string keys;
+    int n = 0;
+
+    check(doc.parse(js) == 15);
+    check(doc.tokens().size() == 15);
+    auto root = doc.root();
+    check(root.is_object() && root.size() == 3);
+    check(root["a"]["b"][1]["c"].text() == "d");
+    check(root["f"].text() == "\\u00e9");
+    check(!root["missing"] && !root["a"]["b"][2] && !root["f"]["x"]);
+    for (auto m : root.members())
+        keys += std::string(m.key) + (m.value.is_array() ? "[]" : "");
+    check(keys == "ae[]f");
+    for (auto v : root["e"].elements())
+        n += v.is_array() + v.is_object() * 10;
+    check(n == 11);
+    for (auto v : root["f"].elements())
+        (void)v, n++;
+    check(n == 11);
+    return 0;
+}
+
+int test_cpp_navigation(void) {
+    check(navigate<jsmn::lenient>() == 0);
+    check(navigate<jsmn::strict>() == 0);
+    check(navigate<jsmn::compat>() == 0);
+    check(navigate<jsmn::large>() == 0);
+    return 0;
+}
+
+struct address {
+    std::string city;
+    int zip = 0;
+};
+
+constexpr auto jsmn_bind(address *) {
+    return jsmn::fields(JSMN_FIELD(address, city), JSMN_FIELD(address, zip));
+}
+
+struct user {
+    std::string user;
+    bool admin = true;
+    long uid = 0;
+    double score = 0;
+    std::string_view raw;
+    std::vector<std::string> groups;
+    std::vector<address> addresses;
+    std::vector<std::vector<int>> grid;
+};
+
+constexpr auto jsmn_bind(user *) {
+    return jsmn::fields(JSMN_FIELD(user, user), JSMN_FIELD(user, admin),
+                        JSMN_FIELD(user, uid), JSMN_FIELD(user, score),
+                        JSMN_FIELD(user, raw), JSMN_FIELD(user, groups),
+                        JSMN_FIELD(user, addresses), JSMN_FIELD(user, grid));
+}
+
+int test_cpp_bind(void) {
+    const char *js =
+        "{\"user\": \"john\\tdoe \\u00e9\\ud83d\\ude00\", \"admin\": false, "
+        "\"uid\": 1000, \"extra\": {\"uid\": 5}, \"score\": -2.5e1, "
+        "\"raw\": \"a\\nb\", \"groups\": [\"users\", \"wheel\"], "
+        "\"addresses\": [{\"city\": \"Oslo\", \"zip\": 150}, {\"zip\": 7}], "
+        "\"grid\": [[1, 2], [], [3]]}";
+    user u;
+    address a;
+    int i;
+
+    /* the table is a perfect hash of the names */
+    for (i = 0; i < (int)jsmn::binding<user>::count; i++)
+        check(jsmn::binding<user>::find(jsmn::binding<user>::names[i]) == i);
+    check(jsmn::binding<user>::find("extra") == -1);
+    check(jsmn::binding<user>::find("") == -1);
+
+    check(jsmn::bind(js, u) == 0);
+    check(u.user == "john\tdoe \xc3\xa9\xf0\x9f\x98\x80");
+    check(!u.admin && u.uid == 1000 && u.score == -25.0);
+    check(u.raw == "a\\nb");
+    check(u.groups.size() == 2 && u.groups[1] == "wheel");
+    check(u.addresses.size() == 2 && u.addresses[0].city == "Oslo");
+    check(u.addresses[0].zip == 150 && u.addresses[1].zip == 7);
+    check(u.addresses[1].city.empty());
+    check(u.grid.size() == 3 && u.grid[0][1] == 2 && u.grid[1].empty());
+
+    check(jsmn::bind<jsmn::strict>("{\"zip\": \"x\"}", a) == JSMN_ERROR_WRONG_TYPE);
+    check(jsmn::bind("{\"zip\": 1.5}", a) == JSMN_ERROR_NOPARSE);
+    check(jsmn::bind("[1]", a) == JSMN_ERROR_WRONG_TYPE);
+    check(jsmn::bind("{\"city\": \"\\u12\"}", a) == JSMN_ERROR_INVAL);
+    return 0;
+}
+
+int main(void) {
+    test(test_cpp_parity, "test C++ parser produces the tokens of the C parser");
+    test(test_cpp_policies, "test C++ parser policies");
+    test(test_cpp_navigation, "test C++ lookups and iteration");
+    test(test_cpp_bind, "test C++ struct binding");
+    printf("\nPASSED: %d\nFAILED: %d\n", test_passed, test_failed);
+    return (test_failed > 0);
+}
@@ -32,16 +32,16 @@ static int vtokeq(const char *s, jsmntok_t *t, int numtok, va_list ap) {
             }
             if (start != -1 && end != -1) {
                 if (t[i].start != start) {
-                    printf("token %d start is %d, not %d\n", i, t[i].start, start);
+                    printf("token %d start is %d, not %d\n", i, (int)t[i].start, start);
                     return 0;
                 }
                 if (t[i].end != end ) {
-                    printf("token %d end is %d, not %d\n", i, t[i].end, end);
+                    printf("token %d end is %d, not %d\n", i, (int)t[i].end, end);
                     return 0;
                 }
             }
             if (size != -1 && t[i].size != size) {
-                printf("token %d size is %d, not %d\n", i, t[i].size, size);
+                printf("token %d size is %d, not %d\n", i, (int)t[i].size, size);
                 return 0;
             }
 
@@ -49,7 +49,7 @@ static int vtokeq(const char *s, jsmntok_t *t, int numtok, va_list ap) {
                 const char *p = s + t[i].start;
                 if (strlen(value) != t[i].end - t[i].start ||
                         strncmp(p, value, t[i].end - t[i].start) != 0) {
-                    printf("token %d value is %.*s, not %s\n", i, t[i].end-t[i].start,
+                    printf("token %d value is %.*s, not %s\n", i, (int)(t[i].end-t[i].start),
                             s+t[i].start, value);
                     return 0;
                 }